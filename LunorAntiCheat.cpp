@@ -1,13 +1,30 @@
 #include <algorithm>
+#include <array>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <unordered_set>
+#include <unordered_map>
 #include <ctime>
 #include <cmath>
 #include <climits>
+#include <cctype>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <shared_mutex>
+#include <future>
+#include <thread>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <cstring>
+#include <cstdint>
 #include "Report.h"
 #include "User.h"
 #include "HWIDBan.h"
+#include "LunorDetectionColumns.h"
 
 const std::unordered_set<std::string> LUNOR_CUSTOM_WHITELIST = {
     "lunor_custom_cosmatics.pak",
@@ -110,6 +127,7 @@ struct PlayerState {
     bool hasAimbot;
     bool hasPacketForge;
     bool hasItemDupe;
+    bool customPakVerified = false;
 
     double movementEntropy;
     double aimSmoothness;
@@ -146,11 +164,145 @@ struct Payload {
     bool isMemoryTamperAttempt;
 };
 
+enum class ValidationCode : unsigned char {
+    Ok,
+    SpeedHack,
+    Teleport,
+    BlockedSource,
+    ESPWallhack,
+    Aimbot,
+    RapidFire,
+    ItemDupe,
+    PacketForge,
+    MemoryTamper,
+    HWIDBanned,
+    OverlayAbuse,
+    ExternalTool,
+    ScoreHack,
+    MoneyHack,
+    Superjump,
+    Superrun,
+    ModMenu,
+    OverlayMod,
+    OverlayDLL,
+    HookDLL,
+    ForceKick,
+    CrashServer,
+    Spoof,
+    FovChanger,
+    SkinChanger,
+    InventoryHack,
+    GlowESP,
+    Chams,
+    Backtrack,
+    HitboxExpander,
+    TeleportHack,
+    Noclip,
+    Godmode,
+    RadarHack,
+    TriggerBot,
+    AutoClicker,
+    Macro,
+    RecoilScript,
+    AntiRecoil,
+    Bypass,
+    CheatEngine,
+    LuaExecutor,
+    PythonInject,
+    ExternalOverlay,
+    Minimap,
+    StatChanger,
+    DamageHack,
+    DropHack,
+    XPBoost,
+    DLLHack,
+    OverlayCheat,
+    SilentAim,
+    SpinBot,
+    FlyHack,
+    Throttled,
+    UnverifiedCustomPak,
+    Count
+};
+
+constexpr std::string_view VALIDATION_REASON_TEXT[] = {
+    "",
+    "Speed hack detected. Action blocked.",
+    "Teleport/position tampering detected.",
+    "Blocked client source.",
+    "ESP/Wallhack/Injector/Overlay detected.",
+    "Aimbot-like behavior detected.",
+    "Rapid fire detected.",
+    "Item duplication cheat detected.",
+    "Packet forging detected.",
+    "Memory tampering detected.",
+    "Device banned.",
+    "Overlay abuse detected.",
+    "External tool detected.",
+    "Score hack detected.",
+    "Money hack detected.",
+    "Superjump detected.",
+    "Superrun detected.",
+    "Mod Menu detected.",
+    "Overlay Mod detected.",
+    "Overlay DLL detected.",
+    "Hook DLL detected.",
+    "Force Kick detected.",
+    "Crash Server detected.",
+    "Spoof detected.",
+    "FOV Changer detected.",
+    "Skin Changer detected.",
+    "Inventory Hack detected.",
+    "Glow ESP detected.",
+    "Chams detected.",
+    "Backtrack detected.",
+    "Hitbox Expander detected.",
+    "Teleport Hack detected.",
+    "Noclip detected.",
+    "Godmode detected.",
+    "Radar Hack detected.",
+    "Trigger Bot detected.",
+    "Auto Clicker detected.",
+    "Macro detected.",
+    "Recoil Script detected.",
+    "Anti Recoil detected.",
+    "Bypass detected.",
+    "Cheat Engine detected.",
+    "Lua Executor detected.",
+    "Python Inject detected.",
+    "External Overlay detected.",
+    "Minimap detected.",
+    "Stat Changer detected.",
+    "Damage Hack detected.",
+    "Drop Hack detected.",
+    "XP Boost detected.",
+    "DLL Hack detected.",
+    "Overlay Cheat detected.",
+    "Silent Aim detected.",
+    "Spin Bot detected.",
+    "Fly Hack detected.",
+    "Too many actions. Slow down.",
+    "Custom pak not verified.",
+};
+
+static_assert(sizeof(VALIDATION_REASON_TEXT) / sizeof(VALIDATION_REASON_TEXT[0]) ==
+              static_cast<size_t>(ValidationCode::Count), "reason text table out of sync with ValidationCode");
+
+// reason points into VALIDATION_REASON_TEXT, so results can be returned and copied without allocating.
 struct ValidationResult {
     bool valid;
-    std::string reason;
+    ValidationCode code;
+    std::string_view reason;
 };
 
+constexpr std::string_view validationReasonText(ValidationCode code) {
+    return VALIDATION_REASON_TEXT[static_cast<size_t>(code)];
+}
+
+inline ValidationResult reject(ValidationCode code) {
+    return {false, code, validationReasonText(code)};
+}
+
 void logSuspicious(const std::string& userId, const std::string& reason, const std::string& details) {
     Report report(userId, reason, details, std::time(nullptr));
     report.save();
@@ -176,21 +328,77 @@ void logAndBlock(const PlayerState& playerState, const std::string& reason, cons
     blockUser(playerState.userId, reason, playerState.hwid);
 }
 
-bool isLunorCustomAllowed(const std::string& src) {
-    std::string lowerSrc = src;
-    std::transform(lowerSrc.begin(), lowerSrc.end(), lowerSrc.begin(), ::tolower);
+// Per-thread bump arena for normalizing client strings on the validation path.
+// Reset at the start of every validatePlayerAction call; views into it are only
+// valid until the next reset on the same thread.
+struct ScratchArena {
+    static const size_t CAPACITY = 4096;
+    char buffer[CAPACITY];
+    size_t used = 0;
+    std::vector<std::unique_ptr<char[]>> overflow;
+
+    void reset() {
+        used = 0;
+        overflow.clear();
+    }
+
+    char* allocate(size_t size) {
+        if (used + size <= CAPACITY) {
+            char* out = buffer + used;
+            used += size;
+            return out;
+        }
+        // Oversized client strings are hostile anyway; fall back to the heap for them.
+        overflow.emplace_back(new char[size]);
+        return overflow.back().get();
+    }
+};
+
+thread_local ScratchArena scratchArena;
+
+std::string_view toLowerScratch(const std::string& value) {
+    char* out = scratchArena.allocate(value.size());
+    std::transform(value.begin(), value.end(), out, [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return std::string_view(out, value.size());
+}
+
+bool isLunorCustomAllowed(std::string_view lowerSrc) {
     for (const auto& allowed : LUNOR_CUSTOM_WHITELIST) {
-        if (lowerSrc.find(allowed) != std::string::npos) return true;
+        if (lowerSrc.find(allowed) != std::string_view::npos) return true;
     }
     return false;
 }
 
-bool isBlockedSource(const std::string& src) {
-    if (isLunorCustomAllowed(src)) return false;
-    std::string lowerSrc = src;
-    std::transform(lowerSrc.begin(), lowerSrc.end(), lowerSrc.begin(), ::tolower);
+// Copies lowerSrc into the scratch arena with every whitelisted pak name removed,
+// so the rest of a verified client's src is still checked against the blocklist.
+std::string_view stripWhitelisted(std::string_view lowerSrc) {
+    char* out = scratchArena.allocate(lowerSrc.size());
+    size_t length = 0;
+    for (size_t i = 0; i < lowerSrc.size();) {
+        size_t skip = 0;
+        for (const auto& allowed : LUNOR_CUSTOM_WHITELIST) {
+            if (lowerSrc.compare(i, allowed.size(), allowed) == 0) {
+                skip = allowed.size();
+                break;
+            }
+        }
+        if (skip > 0) {
+            i += skip;
+        } else {
+            out[length++] = lowerSrc[i++];
+        }
+    }
+    return std::string_view(out, length);
+}
+
+// Only verified clients have their whitelisted pak names stripped before the scan;
+// validatePlayerAction rejects an unverified src naming one before it gets here.
+bool isBlockedSource(std::string_view lowerSrc, bool customPakVerified) {
+    if (customPakVerified && isLunorCustomAllowed(lowerSrc)) lowerSrc = stripWhitelisted(lowerSrc);
     for (const auto& blocked : BLOCKED_SOURCES) {
-        if (lowerSrc.find(blocked) != std::string::npos) return true;
+        if (lowerSrc.find(blocked) != std::string_view::npos) return true;
     }
     return false;
 }
@@ -238,6 +446,1109 @@ bool detectMemoryTamper(const PlayerState& playerState, const Payload& payload)
     return playerState.memoryTamper || payload.isMemoryTamperAttempt;
 }
 
+// --- Custom cosmetic pak verification ---
+//
+// Clients report a manifest for each whitelisted pak at join: the SHA-256 of every
+// PAK_CHUNK_SIZE chunk, the contents of the shipped .sig (HMAC-SHA256 over the
+// manifest root with the local signing key) and the cosmetic item ids they loaded.
+// The whitelist exemption in isBlockedSource only applies once that manifest
+// matches a trusted pak hashed on this server and every item is listed in
+// custom_cosmetics.json. A src naming a whitelisted pak without that is rejected
+// with ValidationCode::UnverifiedCustomPak.
+//
+// This file has no join entry point of its own. The hosting server is expected
+// to call loadPakSigningKey, loadCustomCosmeticItems and loadTrustedPak at
+// startup, then set PlayerState::customPakVerified from
+// verifyCustomPakManifest(...) == PakVerdict::Verified when a player joins.
+// Until it does, the flag stays false and clients reporting a custom pak are
+// turned away rather than exempted.
+
+const size_t PAK_CHUNK_SIZE = 1 << 20;
+const size_t PAK_VERDICT_CACHE_LIMIT = 4096;
+
+using Sha256Digest = std::array<unsigned char, 32>;
+
+const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+struct Sha256 {
+    uint32_t state[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    unsigned char block[64];
+    size_t blockLength = 0;
+    uint64_t totalLength = 0;
+
+    static uint32_t rotr(uint32_t value, int bits) {
+        return (value >> bits) | (value << (32 - bits));
+    }
+
+    void transform(const unsigned char* chunk) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (uint32_t(chunk[i * 4]) << 24) | (uint32_t(chunk[i * 4 + 1]) << 16) |
+                   (uint32_t(chunk[i * 4 + 2]) << 8) | uint32_t(chunk[i * 4 + 3]);
+        }
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+
+    void update(const unsigned char* data, size_t length) {
+        totalLength += length;
+        while (length > 0) {
+            size_t take = std::min(length, sizeof(block) - blockLength);
+            std::memcpy(block + blockLength, data, take);
+            blockLength += take;
+            data += take;
+            length -= take;
+            if (blockLength == sizeof(block)) {
+                transform(block);
+                blockLength = 0;
+            }
+        }
+    }
+
+    void update(std::string_view data) {
+        update(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    }
+
+    Sha256Digest finish() {
+        uint64_t bitLength = totalLength * 8;
+        unsigned char pad = 0x80;
+        update(&pad, 1);
+        pad = 0;
+        while (blockLength != 56) update(&pad, 1);
+        unsigned char lengthBytes[8];
+        for (int i = 0; i < 8; ++i) lengthBytes[i] = static_cast<unsigned char>(bitLength >> (56 - i * 8));
+        update(lengthBytes, 8);
+        Sha256Digest digest;
+        for (int i = 0; i < 8; ++i) {
+            digest[i * 4] = static_cast<unsigned char>(state[i] >> 24);
+            digest[i * 4 + 1] = static_cast<unsigned char>(state[i] >> 16);
+            digest[i * 4 + 2] = static_cast<unsigned char>(state[i] >> 8);
+            digest[i * 4 + 3] = static_cast<unsigned char>(state[i]);
+        }
+        return digest;
+    }
+};
+
+Sha256Digest sha256(std::string_view data) {
+    Sha256 hasher;
+    hasher.update(data);
+    return hasher.finish();
+}
+
+Sha256Digest hmacSha256(std::string_view key, std::string_view message) {
+    unsigned char keyBlock[64] = {};
+    if (key.size() > sizeof(keyBlock)) {
+        Sha256Digest hashedKey = sha256(key);
+        std::memcpy(keyBlock, hashedKey.data(), hashedKey.size());
+    } else {
+        std::memcpy(keyBlock, key.data(), key.size());
+    }
+    unsigned char innerPad[64];
+    unsigned char outerPad[64];
+    for (size_t i = 0; i < sizeof(keyBlock); ++i) {
+        innerPad[i] = keyBlock[i] ^ 0x36;
+        outerPad[i] = keyBlock[i] ^ 0x5c;
+    }
+    Sha256 inner;
+    inner.update(innerPad, sizeof(innerPad));
+    inner.update(message);
+    Sha256Digest innerDigest = inner.finish();
+    Sha256 outer;
+    outer.update(outerPad, sizeof(outerPad));
+    outer.update(innerDigest.data(), innerDigest.size());
+    return outer.finish();
+}
+
+std::string toHex(const Sha256Digest& digest) {
+    static const char HEX[] = "0123456789abcdef";
+    std::string out(digest.size() * 2, '0');
+    for (size_t i = 0; i < digest.size(); ++i) {
+        out[i * 2] = HEX[digest[i] >> 4];
+        out[i * 2 + 1] = HEX[digest[i] & 15];
+    }
+    return out;
+}
+
+std::string toLowerCopy(std::string_view value) {
+    std::string out(value);
+    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return out;
+}
+
+bool constantTimeEquals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    unsigned char diff = 0;
+    for (size_t i = 0; i < a.size(); ++i) diff |= static_cast<unsigned char>(a[i] ^ b[i]);
+    return diff == 0;
+}
+
+// Root of a manifest: SHA-256 over the lowercase hex chunk hashes, newline separated.
+std::string manifestRoot(const std::vector<std::string>& chunkHashes) {
+    Sha256 hasher;
+    for (const auto& chunkHash : chunkHashes) {
+        hasher.update(chunkHash);
+        hasher.update("\n");
+    }
+    return toHex(hasher.finish());
+}
+
+enum class PakVerdict : unsigned char {
+    Verified,
+    UnknownPak,
+    ChunkMismatch,
+    BadSignature,
+    UnknownItem
+};
+
+struct PakManifest {
+    std::string pakName;
+    std::vector<std::string> chunkHashes;
+    std::string signature;
+    std::vector<std::string> itemIds;
+};
+
+struct TrustedPak {
+    std::vector<std::string> chunkHashes;
+    std::string root;
+    std::string signature;
+};
+
+std::shared_mutex pakRegistryMutex;
+std::string pakSigningKey;
+std::unordered_map<std::string, TrustedPak> trustedPaks;
+std::unordered_set<std::string> customCosmeticItems;
+
+std::mutex pakVerdictCacheMutex;
+std::unordered_map<std::string, std::shared_future<PakVerdict>> pakVerdictCache;
+
+bool readFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+std::string trimmed(const std::string& value) {
+    size_t begin = value.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return "";
+    size_t end = value.find_last_not_of(" \t\r\n");
+    return value.substr(begin, end - begin + 1);
+}
+
+// Trusted paks and cached verdicts were accepted under the previous key, so a
+// key change drops both; paks must be loaded again under the new key.
+void loadPakSigningKey(const std::string& key) {
+    std::unique_lock<std::shared_mutex> lock(pakRegistryMutex);
+    if (key == pakSigningKey) return;
+    pakSigningKey = key;
+    trustedPaks.clear();
+    std::lock_guard<std::mutex> cacheLock(pakVerdictCacheMutex);
+    pakVerdictCache.clear();
+}
+
+// Collects every "id" string from custom_cosmetics.json. Only the subset of JSON
+// that file uses (objects, arrays and plain strings) needs to be understood.
+bool loadCustomCosmeticItems(const std::string& path) {
+    std::string json;
+    if (!readFile(path, json)) return false;
+
+    std::unordered_set<std::string> items;
+    std::string token;
+    bool expectId = false;
+    for (size_t i = 0; i < json.size(); ++i) {
+        if (json[i] != '"') continue;
+        token.clear();
+        for (++i; i < json.size() && json[i] != '"'; ++i) {
+            if (json[i] == '\\' && i + 1 < json.size()) ++i;
+            token += json[i];
+        }
+        size_t next = json.find_first_not_of(" \t\r\n", i + 1);
+        bool isKey = next != std::string::npos && json[next] == ':';
+        if (expectId && !isKey) items.insert(toLowerCopy(token));
+        expectId = isKey && token == "id";
+    }
+
+    std::unique_lock<std::shared_mutex> lock(pakRegistryMutex);
+    customCosmeticItems.swap(items);
+    return true;
+}
+
+// Hashes the server's copy of a pak in parallel, one strided slice of chunks per
+// hardware thread, and registers it only if its .sig verifies against the local key.
+bool loadTrustedPak(const std::string& pakName, const std::string& pakPath, const std::string& sigPath) {
+    std::string data;
+    std::string signature;
+    if (!readFile(pakPath, data) || !readFile(sigPath, signature)) return false;
+    signature = toLowerCopy(trimmed(signature));
+
+    size_t chunkCount = std::max<size_t>(1, (data.size() + PAK_CHUNK_SIZE - 1) / PAK_CHUNK_SIZE);
+    size_t workerCount = std::min<size_t>(chunkCount, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::string> chunkHashes(chunkCount);
+    std::vector<std::future<void>> workers;
+    std::string_view view(data);
+    for (size_t w = 0; w < workerCount; ++w) {
+        workers.push_back(std::async(std::launch::async, [&, w] {
+            for (size_t chunk = w; chunk < chunkCount; chunk += workerCount) {
+                size_t offset = chunk * PAK_CHUNK_SIZE;
+                chunkHashes[chunk] = toHex(sha256(view.substr(std::min(offset, view.size()), PAK_CHUNK_SIZE)));
+            }
+        }));
+    }
+    for (auto& worker : workers) worker.get();
+
+    TrustedPak pak;
+    pak.root = manifestRoot(chunkHashes);
+    pak.chunkHashes = std::move(chunkHashes);
+    pak.signature = signature;
+
+    std::unique_lock<std::shared_mutex> lock(pakRegistryMutex);
+    if (pakSigningKey.empty() || !constantTimeEquals(toHex(hmacSha256(pakSigningKey, pak.root)), signature)) {
+        return false;
+    }
+    trustedPaks[toLowerCopy(pakName)] = std::move(pak);
+    {
+        std::lock_guard<std::mutex> cacheLock(pakVerdictCacheMutex);
+        pakVerdictCache.clear();
+    }
+    return true;
+}
+
+PakVerdict verifyPakContent(const PakManifest& manifest) {
+    std::shared_lock<std::shared_mutex> lock(pakRegistryMutex);
+    auto it = trustedPaks.find(toLowerCopy(manifest.pakName));
+    if (it == trustedPaks.end()) return PakVerdict::UnknownPak;
+    const TrustedPak& trusted = it->second;
+
+    if (manifest.chunkHashes.size() != trusted.chunkHashes.size()) return PakVerdict::ChunkMismatch;
+    std::vector<std::string> chunkHashes;
+    chunkHashes.reserve(manifest.chunkHashes.size());
+    for (size_t i = 0; i < manifest.chunkHashes.size(); ++i) {
+        chunkHashes.push_back(toLowerCopy(manifest.chunkHashes[i]));
+        if (!constantTimeEquals(chunkHashes.back(), trusted.chunkHashes[i])) return PakVerdict::ChunkMismatch;
+    }
+
+    std::string expected = toHex(hmacSha256(pakSigningKey, manifestRoot(chunkHashes)));
+    if (!constantTimeEquals(expected, toLowerCopy(manifest.signature))) return PakVerdict::BadSignature;
+    return PakVerdict::Verified;
+}
+
+// Pak verdicts are memoized by a hash of the reported content, and concurrent
+// joins with the same content wait on the one in-flight verification.
+PakVerdict verifyCustomPakManifest(const PakManifest& manifest) {
+    Sha256 keyHasher;
+    keyHasher.update(toLowerCopy(manifest.pakName));
+    for (const auto& chunkHash : manifest.chunkHashes) {
+        keyHasher.update("\n");
+        keyHasher.update(toLowerCopy(chunkHash));
+    }
+    keyHasher.update("\n");
+    keyHasher.update(toLowerCopy(manifest.signature));
+    std::string contentKey = toHex(keyHasher.finish());
+
+    std::shared_future<PakVerdict> verdict;
+    std::promise<PakVerdict> promise;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(pakVerdictCacheMutex);
+        auto it = pakVerdictCache.find(contentKey);
+        if (it != pakVerdictCache.end()) {
+            verdict = it->second;
+        } else {
+            if (pakVerdictCache.size() >= PAK_VERDICT_CACHE_LIMIT) pakVerdictCache.clear();
+            verdict = promise.get_future().share();
+            pakVerdictCache.emplace(contentKey, verdict);
+            owner = true;
+        }
+    }
+    if (owner) {
+        try {
+            promise.set_value(verifyPakContent(manifest));
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }
+
+    PakVerdict result = verdict.get();
+    if (result != PakVerdict::Verified) return result;
+
+    std::shared_lock<std::shared_mutex> lock(pakRegistryMutex);
+    for (const auto& itemId : manifest.itemIds) {
+        if (customCosmeticItems.count(toLowerCopy(itemId)) == 0) return PakVerdict::UnknownItem;
+    }
+    return PakVerdict::Verified;
+}
+
+// --- Action admission control ---
+//
+// Token buckets per player and per HWID, checked before any detector runs so
+// action floods (crashserver/forcekick style) cannot burn validation and Report
+// I/O. Buckets live in a fixed, sharded, open-addressed table and are refilled
+// lazily from a coarse tick clock when next touched. One in
+// ADMISSION_SAMPLE_EVERY excess actions is still validated so a flooding cheat
+// is caught by its other signals.
+
+const unsigned ADMISSION_TICK_MS = 16;
+const unsigned ADMISSION_TOKEN_UNIT = 64;
+const unsigned ADMISSION_PLAYER_RATE = 60;
+const unsigned ADMISSION_PLAYER_BURST = 120;
+const unsigned ADMISSION_HWID_RATE = 90;
+const unsigned ADMISSION_HWID_BURST = 180;
+const unsigned ADMISSION_SAMPLE_EVERY = 64;
+const size_t ADMISSION_SHARDS = 64;
+const size_t ADMISSION_SHARD_SLOTS = 2048;
+const size_t ADMISSION_MAX_PROBE = 16;
+const uint64_t ADMISSION_PLAYER_SEED = 0xcbf29ce484222325ULL;
+const uint64_t ADMISSION_HWID_SEED = 0x84222325cbf29ce4ULL;
+
+enum class AdmissionDecision : unsigned char {
+    Admitted,
+    Sampled,
+    Throttled,
+    FloodStarted
+};
+
+struct AdmissionBucket {
+    uint64_t key;
+    uint32_t lastTick;
+    uint16_t tokens;
+    uint16_t throttled;
+};
+
+static_assert(sizeof(AdmissionBucket) == 16, "admission buckets should stay one quarter of a cache line");
+
+struct AdmissionShard {
+    std::mutex mutex;
+    AdmissionBucket buckets[ADMISSION_SHARD_SLOTS];
+};
+
+struct AdmissionStats {
+    std::atomic<unsigned long long> admitted{0};
+    std::atomic<unsigned long long> sampled{0};
+    std::atomic<unsigned long long> throttled{0};
+    std::atomic<unsigned long long> floodEpisodes{0};
+    std::atomic<unsigned long long> evictions{0};
+};
+
+AdmissionShard admissionTable[ADMISSION_SHARDS];
+AdmissionStats admissionStats;
+
+uint32_t admissionTick() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count() / ADMISSION_TICK_MS);
+}
+
+uint64_t admissionKey(std::string_view id, uint64_t seed) {
+    uint64_t hash = seed;
+    for (unsigned char c : id) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+// Ticks elapsed from lastTick to tick. Callers read the clock before taking the
+// shard lock, so tick can trail a lastTick another thread just stored; that, and
+// anything else that looks like time running backwards, counts as no time at all
+// instead of wrapping to ~2^32 ticks.
+uint32_t admissionTicksSince(uint32_t tick, uint32_t lastTick) {
+    int32_t elapsed = static_cast<int32_t>(tick - lastTick);
+    return elapsed > 0 ? static_cast<uint32_t>(elapsed) : 0;
+}
+
+// Finds the bucket for key, or claims the stalest slot in its probe window.
+AdmissionBucket& admissionBucket(AdmissionShard& shard, uint64_t key, uint32_t tick, unsigned burst) {
+    size_t start = static_cast<size_t>(key) & (ADMISSION_SHARD_SLOTS - 1);
+    AdmissionBucket* victim = nullptr;
+    for (size_t probe = 0; probe < ADMISSION_MAX_PROBE; ++probe) {
+        AdmissionBucket& bucket = shard.buckets[(start + probe) & (ADMISSION_SHARD_SLOTS - 1)];
+        if (bucket.key == key) return bucket;
+        if (bucket.key == 0) {
+            victim = &bucket;
+            break;
+        }
+        if (!victim || admissionTicksSince(tick, bucket.lastTick) > admissionTicksSince(tick, victim->lastTick)) {
+            victim = &bucket;
+        }
+    }
+    if (victim->key != 0) admissionStats.evictions.fetch_add(1, std::memory_order_relaxed);
+    victim->key = key;
+    victim->lastTick = tick;
+    victim->tokens = static_cast<uint16_t>(burst * ADMISSION_TOKEN_UNIT);
+    victim->throttled = 0;
+    return *victim;
+}
+
+AdmissionDecision takeToken(std::string_view id, uint64_t seed, unsigned rate, unsigned burst, uint32_t tick) {
+    uint64_t key = admissionKey(id, seed);
+    AdmissionShard& shard = admissionTable[key >> 58];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    AdmissionBucket& bucket = admissionBucket(shard, key, tick, burst);
+
+    uint64_t refill = static_cast<uint64_t>(admissionTicksSince(tick, bucket.lastTick)) * rate * ADMISSION_TOKEN_UNIT *
+                      ADMISSION_TICK_MS / 1000;
+    bucket.tokens = static_cast<uint16_t>(std::min<uint64_t>(bucket.tokens + refill, burst * ADMISSION_TOKEN_UNIT));
+    if (refill > 0) bucket.lastTick = tick;
+    // A flood episode only ends once the bucket has refilled completely; single
+    // tokens trickling back in during a flood do not reset the excess count.
+    if (bucket.tokens == burst * ADMISSION_TOKEN_UNIT) bucket.throttled = 0;
+
+    if (bucket.tokens >= ADMISSION_TOKEN_UNIT) {
+        bucket.tokens -= ADMISSION_TOKEN_UNIT;
+        return AdmissionDecision::Admitted;
+    }
+    bucket.throttled = bucket.throttled == UINT16_MAX ? ADMISSION_SAMPLE_EVERY : bucket.throttled + 1;
+    if (bucket.throttled == 1) return AdmissionDecision::FloodStarted;
+    if (bucket.throttled % ADMISSION_SAMPLE_EVERY == 0) return AdmissionDecision::Sampled;
+    return AdmissionDecision::Throttled;
+}
+
+AdmissionDecision admitAction(const PlayerState& playerState) {
+    uint32_t tick = admissionTick();
+    AdmissionDecision decision = takeToken(playerState.userId, ADMISSION_PLAYER_SEED,
+                                           ADMISSION_PLAYER_RATE, ADMISSION_PLAYER_BURST, tick);
+    if (decision == AdmissionDecision::Admitted && !playerState.hwid.empty()) {
+        decision = takeToken(playerState.hwid, ADMISSION_HWID_SEED, ADMISSION_HWID_RATE, ADMISSION_HWID_BURST, tick);
+    }
+
+    switch (decision) {
+        case AdmissionDecision::Admitted:
+            admissionStats.admitted.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case AdmissionDecision::Sampled:
+            admissionStats.sampled.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case AdmissionDecision::FloodStarted:
+            admissionStats.floodEpisodes.fetch_add(1, std::memory_order_relaxed);
+            admissionStats.throttled.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case AdmissionDecision::Throttled:
+            admissionStats.throttled.fetch_add(1, std::memory_order_relaxed);
+            break;
+    }
+    return decision;
+}
+
+// --- Long-horizon trajectory history ---
+//
+// Keeps TRAJECTORY_RETENTION_MS of position, aim angle and timestamp per player
+// for windowed checks that need more than previousState. Samples are quantized
+// and stored as bit-packed delta-of-deltas in fixed-size chunks drawn from a
+// shared pool. Each chunk restarts the encoding, so expired chunks are simply
+// unlinked from the front and a window can be decoded starting at any chunk.
+// Smooth 30 Hz movement costs under two bytes per sample.
+//
+// Samples are keyed on server receive time, clamped so a player's history never
+// goes backwards. Players that stop sending are dropped by an incremental sweep
+// that validatePlayerAction runs on one shard every TRAJECTORY_SWEEP_INTERVAL_MS.
+//
+// The host calls reserveTrajectoryCapacity at startup with its expected player
+// count so recording does not allocate slabs or rehash shards mid-match. A
+// player's first sample still allocates its map node, plus a copy of the userId
+// when it is longer than the small-string buffer; every later sample is
+// allocation-free.
+
+const long long TRAJECTORY_RETENTION_MS = 10 * 60 * 1000;
+const size_t TRAJECTORY_CHUNK_BYTES = 512;
+const size_t TRAJECTORY_SLAB_CHUNKS = 256;
+const size_t TRAJECTORY_SHARDS = 16;
+const double TRAJECTORY_POSITION_SCALE = 10.0;
+const double TRAJECTORY_ANGLE_SCALE = 10.0;
+const size_t TRAJECTORY_FIELDS = 4;
+const int64_t TRAJECTORY_ANGLE_TURN = static_cast<int64_t>(360 * TRAJECTORY_ANGLE_SCALE);
+// Quantized values are clamped to this magnitude so delta-of-deltas cannot overflow.
+const int64_t TRAJECTORY_QUANTIZED_LIMIT = int64_t(1) << 40;
+const long long TRAJECTORY_SWEEP_INTERVAL_MS = 1000;
+
+// Every field stores a delta-of-delta. Aim is normalized to [0, 360) and its
+// deltas are wrapped to the shorter way round the circle.
+const bool TRAJECTORY_CIRCULAR[TRAJECTORY_FIELDS] = {false, false, false, true};
+
+// Each delta-of-delta is a unary class prefix (0, 10, 110, ...) followed by the
+// value as a two's-complement integer of the class width. Smooth movement keeps
+// most values in the first two classes.
+struct TrajectoryBitClass {
+    unsigned prefixBits;
+    unsigned valueBits;
+};
+
+const TrajectoryBitClass TRAJECTORY_BIT_CLASSES[] = {
+    {1, 0},
+    {2, 2},
+    {3, 5},
+    {4, 9},
+    {5, 20},
+    {5, 64}
+};
+
+const size_t TRAJECTORY_BIT_CLASS_COUNT = sizeof(TRAJECTORY_BIT_CLASSES) / sizeof(TRAJECTORY_BIT_CLASSES[0]);
+
+// Class of a value from the next five bits of the stream, so decoding does not
+// branch on the prefix.
+const unsigned char TRAJECTORY_PREFIX_CLASS[32] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2,
+    3, 3,
+    4,
+    5
+};
+
+const size_t TRAJECTORY_MAX_SAMPLE_BYTES = (TRAJECTORY_FIELDS * (5 + 64) + 7) / 8;
+
+struct TrajectorySample {
+    long long timestamp;
+    double x;
+    double y;
+    double aimAngle;
+};
+
+struct TrajectoryChunk {
+    TrajectoryChunk* next;
+    long long firstTimestamp;
+    long long lastTimestamp;
+    uint16_t usedBits;
+    uint16_t count;
+    unsigned char data[TRAJECTORY_CHUNK_BYTES - 2 * sizeof(long long) - sizeof(void*) - 2 * sizeof(uint16_t)];
+};
+
+static_assert(sizeof(TrajectoryChunk) == TRAJECTORY_CHUNK_BYTES, "trajectory chunks should pack to TRAJECTORY_CHUNK_BYTES");
+
+// Encoder/decoder state for timestamp, x, y and aim angle, reset at every chunk
+// start with the timestamp seeded from the chunk's firstTimestamp.
+struct TrajectoryCodec {
+    int64_t previous[TRAJECTORY_FIELDS] = {};
+    int64_t previousDelta[TRAJECTORY_FIELDS] = {};
+};
+
+struct PlayerTrajectory {
+    TrajectoryChunk* head = nullptr;
+    TrajectoryChunk* tail = nullptr;
+    TrajectoryCodec encoder;
+};
+
+class TrajectoryChunkPool {
+public:
+    TrajectoryChunk* acquire() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeList) addSlab();
+        TrajectoryChunk* chunk = freeList;
+        freeList = chunk->next;
+        ++inUse;
+        return chunk;
+    }
+
+    void release(TrajectoryChunk* chunk) {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunk->next = freeList;
+        freeList = chunk;
+        --inUse;
+    }
+
+    // Allocates slabs until at least chunks are free.
+    void reserve(size_t chunks) {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (slabs.size() * TRAJECTORY_SLAB_CHUNKS - inUse < chunks) addSlab();
+    }
+
+    size_t chunksInUse() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return inUse;
+    }
+
+    size_t reservedBytes() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return slabs.size() * TRAJECTORY_SLAB_CHUNKS * sizeof(TrajectoryChunk);
+    }
+
+private:
+    void addSlab() {
+        slabs.emplace_back(new TrajectoryChunk[TRAJECTORY_SLAB_CHUNKS]);
+        for (size_t i = 0; i < TRAJECTORY_SLAB_CHUNKS; ++i) {
+            slabs.back()[i].next = freeList;
+            freeList = &slabs.back()[i];
+        }
+    }
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<TrajectoryChunk[]>> slabs;
+    TrajectoryChunk* freeList = nullptr;
+    size_t inUse = 0;
+};
+
+struct TrajectoryShard {
+    std::mutex mutex;
+    std::unordered_map<std::string, PlayerTrajectory> players;
+};
+
+TrajectoryChunkPool trajectoryChunkPool;
+TrajectoryShard trajectoryShards[TRAJECTORY_SHARDS];
+
+std::atomic<long long> trajectoryNextSweepMs{0};
+std::atomic<size_t> trajectorySweepCursor{0};
+
+TrajectoryShard& trajectoryShard(const std::string& userId) {
+    return trajectoryShards[std::hash<std::string>()(userId) % TRAJECTORY_SHARDS];
+}
+
+long long trajectoryNowMs() {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+}
+
+int64_t quantizeTrajectory(double value, double scale) {
+    double scaled = value * scale;
+    if (!(scaled > -static_cast<double>(TRAJECTORY_QUANTIZED_LIMIT))) {
+        return std::isnan(scaled) ? 0 : -TRAJECTORY_QUANTIZED_LIMIT;
+    }
+    if (scaled > static_cast<double>(TRAJECTORY_QUANTIZED_LIMIT)) return TRAJECTORY_QUANTIZED_LIMIT;
+    return std::llround(scaled);
+}
+
+int64_t quantizeTrajectoryAngle(double degrees) {
+    int64_t angle = quantizeTrajectory(degrees, TRAJECTORY_ANGLE_SCALE) % TRAJECTORY_ANGLE_TURN;
+    return angle < 0 ? angle + TRAJECTORY_ANGLE_TURN : angle;
+}
+
+// Appends bits most significant first; bytes are cleared as they are first touched.
+struct TrajectoryBitWriter {
+    unsigned char* data;
+    size_t bit;
+
+    void put(uint64_t value, unsigned count) {
+        while (count > 0) {
+            unsigned room = 8 - static_cast<unsigned>(bit & 7);
+            unsigned take = std::min(room, count);
+            unsigned bits = static_cast<unsigned>(value >> (count - take)) & ((1u << take) - 1);
+            if ((bit & 7) == 0) data[bit >> 3] = 0;
+            data[bit >> 3] |= static_cast<unsigned char>(bits << (room - take));
+            bit += take;
+            count -= take;
+        }
+    }
+};
+
+// Keeps up to 64 unread bits left-aligned in a register, refilled a word at a time.
+struct TrajectoryBitReader {
+    const unsigned char* data;
+    size_t size;
+    size_t next = 0;
+    uint64_t buffer = 0;
+    unsigned count = 0;
+
+    // Tops the buffer up to at least 56 bits; bytes past size read as zero.
+    void refill() {
+        if (next + 8 <= size) {
+            const unsigned char* p = data + next;
+            uint64_t word = uint64_t(p[0]) << 56 | uint64_t(p[1]) << 48 | uint64_t(p[2]) << 40 | uint64_t(p[3]) << 32 |
+                            uint64_t(p[4]) << 24 | uint64_t(p[5]) << 16 | uint64_t(p[6]) << 8 | uint64_t(p[7]);
+            buffer |= word >> count;
+            next += (63 - count) >> 3;
+            count |= 56;
+        } else {
+            while (count <= 56) {
+                buffer |= uint64_t(next < size ? data[next] : 0) << (56 - count);
+                ++next;
+                count += 8;
+            }
+        }
+    }
+
+    // bits must be between 1 and 56 and no more than are buffered.
+    uint64_t get(unsigned bits) {
+        uint64_t value = buffer >> (64 - bits);
+        buffer <<= bits;
+        count -= bits;
+        return value;
+    }
+};
+
+void putTrajectoryValue(TrajectoryBitWriter& out, int64_t value) {
+    for (size_t c = 0; c < TRAJECTORY_BIT_CLASS_COUNT; ++c) {
+        const TrajectoryBitClass& bitClass = TRAJECTORY_BIT_CLASSES[c];
+        bool last = c + 1 == TRAJECTORY_BIT_CLASS_COUNT;
+        if (!last) {
+            int64_t half = bitClass.valueBits == 0 ? 0 : int64_t(1) << (bitClass.valueBits - 1);
+            bool fits = bitClass.valueBits == 0 ? value == 0 : value >= -half && value < half;
+            if (!fits) continue;
+        }
+        // The prefix is c ones then a zero; the last class drops the zero.
+        uint64_t prefix = ((uint64_t(1) << c) - 1) << (bitClass.prefixBits - c);
+        out.put(prefix, bitClass.prefixBits);
+        if (bitClass.valueBits == 64) {
+            out.put(static_cast<uint64_t>(value), 64);
+        } else if (bitClass.valueBits > 0) {
+            out.put(static_cast<uint64_t>(value) & ((uint64_t(1) << bitClass.valueBits) - 1), bitClass.valueBits);
+        }
+        return;
+    }
+}
+
+int64_t getTrajectoryValue(TrajectoryBitReader& in) {
+    in.refill();
+    const TrajectoryBitClass& bitClass = TRAJECTORY_BIT_CLASSES[TRAJECTORY_PREFIX_CLASS[in.buffer >> 59]];
+    if (bitClass.valueBits == 64) {
+        in.get(bitClass.prefixBits);
+        in.refill();
+        uint64_t high = in.get(32);
+        in.refill();
+        return static_cast<int64_t>((high << 32) | in.get(32));
+    }
+    // Shifting by 1 then 63 - valueBits keeps the zero-width class at 0 without a branch.
+    uint64_t raw = (in.buffer << bitClass.prefixBits) >> 1 >> (63 - bitClass.valueBits);
+    uint64_t sign = (uint64_t(1) << bitClass.valueBits) >> 1;
+    in.buffer <<= bitClass.prefixBits + bitClass.valueBits;
+    in.count -= bitClass.prefixBits + bitClass.valueBits;
+    return static_cast<int64_t>((raw ^ sign) - sign);
+}
+
+// Maps a difference of two values in (-TURN, TURN) to the short way round, [-TURN/2, TURN/2).
+int64_t wrapTrajectoryAngle(int64_t delta) {
+    if (delta >= TRAJECTORY_ANGLE_TURN / 2) return delta - TRAJECTORY_ANGLE_TURN;
+    if (delta < -TRAJECTORY_ANGLE_TURN / 2) return delta + TRAJECTORY_ANGLE_TURN;
+    return delta;
+}
+
+void encodeTrajectorySample(TrajectoryCodec& codec, const int64_t (&values)[TRAJECTORY_FIELDS], TrajectoryBitWriter& out) {
+    for (size_t field = 0; field < TRAJECTORY_FIELDS; ++field) {
+        int64_t delta = values[field] - codec.previous[field];
+        int64_t deltaOfDelta = delta - codec.previousDelta[field];
+        if (TRAJECTORY_CIRCULAR[field]) {
+            // Both angles are in [0, TURN) and both deltas wrapped, so one wrap each suffices.
+            delta = wrapTrajectoryAngle(delta);
+            deltaOfDelta = wrapTrajectoryAngle(delta - codec.previousDelta[field]);
+        }
+        putTrajectoryValue(out, deltaOfDelta);
+        codec.previous[field] = values[field];
+        codec.previousDelta[field] = delta;
+    }
+}
+
+void decodeTrajectorySample(TrajectoryCodec& codec, TrajectoryBitReader& in) {
+    for (size_t field = 0; field < TRAJECTORY_FIELDS; ++field) {
+        int64_t delta = codec.previousDelta[field] + getTrajectoryValue(in);
+        if (TRAJECTORY_CIRCULAR[field]) {
+            delta = wrapTrajectoryAngle(delta);
+            int64_t angle = codec.previous[field] + delta;
+            if (angle < 0) angle += TRAJECTORY_ANGLE_TURN;
+            if (angle >= TRAJECTORY_ANGLE_TURN) angle -= TRAJECTORY_ANGLE_TURN;
+            codec.previous[field] = angle;
+        } else {
+            codec.previous[field] += delta;
+        }
+        codec.previousDelta[field] = delta;
+    }
+}
+
+TrajectoryCodec trajectoryChunkCodec(const TrajectoryChunk& chunk) {
+    TrajectoryCodec codec;
+    codec.previous[0] = chunk.firstTimestamp;
+    return codec;
+}
+
+void releaseTrajectoryChunks(PlayerTrajectory& trajectory) {
+    while (trajectory.head) {
+        TrajectoryChunk* next = trajectory.head->next;
+        trajectoryChunkPool.release(trajectory.head);
+        trajectory.head = next;
+    }
+    trajectory.tail = nullptr;
+}
+
+void expireTrajectoryChunks(PlayerTrajectory& trajectory, long long nowMs) {
+    while (trajectory.head != trajectory.tail && trajectory.head->lastTimestamp < nowMs - TRAJECTORY_RETENTION_MS) {
+        TrajectoryChunk* expired = trajectory.head;
+        trajectory.head = expired->next;
+        trajectoryChunkPool.release(expired);
+    }
+}
+
+// Records a sample at server time timestamp (ms). Timestamps earlier than the
+// player's last sample are clamped to it, so decoding stays in order.
+void recordTrajectory(const std::string& userId, long long timestamp, double x, double y, double aimAngle) {
+    TrajectoryShard& shard = trajectoryShard(userId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.players.find(userId);
+    if (it == shard.players.end()) it = shard.players.emplace(userId, PlayerTrajectory{}).first;
+    PlayerTrajectory& trajectory = it->second;
+    if (trajectory.tail) timestamp = std::max(timestamp, trajectory.tail->lastTimestamp);
+    int64_t values[TRAJECTORY_FIELDS] = {
+        timestamp,
+        quantizeTrajectory(x, TRAJECTORY_POSITION_SCALE),
+        quantizeTrajectory(y, TRAJECTORY_POSITION_SCALE),
+        quantizeTrajectoryAngle(aimAngle)
+    };
+
+    unsigned char encoded[TRAJECTORY_MAX_SAMPLE_BYTES];
+    TrajectoryBitWriter scratch{encoded, 0};
+    TrajectoryCodec codec = trajectory.encoder;
+    encodeTrajectorySample(codec, values, scratch);
+    TrajectoryChunk* tail = trajectory.tail;
+    if (!tail || tail->usedBits + scratch.bit > sizeof(tail->data) * 8) {
+        TrajectoryChunk* chunk = trajectoryChunkPool.acquire();
+        chunk->next = nullptr;
+        chunk->firstTimestamp = timestamp;
+        chunk->usedBits = 0;
+        chunk->count = 0;
+        if (tail) tail->next = chunk;
+        else trajectory.head = chunk;
+        trajectory.tail = tail = chunk;
+        codec = trajectoryChunkCodec(*chunk);
+        scratch.bit = 0;
+        encodeTrajectorySample(codec, values, scratch);
+    }
+    TrajectoryBitWriter out{tail->data, tail->usedBits};
+    for (size_t bit = 0; bit < scratch.bit; bit += 8) {
+        unsigned count = static_cast<unsigned>(std::min<size_t>(8, scratch.bit - bit));
+        out.put(encoded[bit >> 3] >> (8 - count), count);
+    }
+    tail->usedBits = static_cast<uint16_t>(out.bit);
+    ++tail->count;
+    tail->lastTimestamp = timestamp;
+    trajectory.encoder = codec;
+    expireTrajectoryChunks(trajectory, timestamp);
+}
+
+void forgetTrajectory(const std::string& userId) {
+    TrajectoryShard& shard = trajectoryShard(userId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.players.find(userId);
+    if (it == shard.players.end()) return;
+    releaseTrajectoryChunks(it->second);
+    shard.players.erase(it);
+}
+
+// Drops players in shard whose last sample is older than the retention window
+// and trims expired chunks from everyone else.
+void sweepTrajectoryShard(TrajectoryShard& shard, long long nowMs) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto it = shard.players.begin(); it != shard.players.end();) {
+        PlayerTrajectory& trajectory = it->second;
+        if (!trajectory.tail || trajectory.tail->lastTimestamp < nowMs - TRAJECTORY_RETENTION_MS) {
+            releaseTrajectoryChunks(trajectory);
+            it = shard.players.erase(it);
+        } else {
+            expireTrajectoryChunks(trajectory, nowMs);
+            ++it;
+        }
+    }
+}
+
+void sweepTrajectories(long long nowMs) {
+    for (TrajectoryShard& shard : trajectoryShards) sweepTrajectoryShard(shard, nowMs);
+}
+
+// Pre-sizes the store for players recording at once and chunks of free pool
+// space. Each shard gets buckets for twice its even share of players, so uneven
+// hashing does not trigger a rehash.
+void reserveTrajectoryCapacity(size_t players, size_t chunks) {
+    trajectoryChunkPool.reserve(chunks);
+    for (TrajectoryShard& shard : trajectoryShards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.players.reserve(2 * players / TRAJECTORY_SHARDS + 1);
+    }
+}
+
+// Sweeps the next shard if TRAJECTORY_SWEEP_INTERVAL_MS has passed since the
+// last one; only the caller that claims the interval does any work.
+void maybeSweepTrajectories(long long nowMs) {
+    long long due = trajectoryNextSweepMs.load(std::memory_order_relaxed);
+    if (nowMs < due) return;
+    if (!trajectoryNextSweepMs.compare_exchange_strong(due, nowMs + TRAJECTORY_SWEEP_INTERVAL_MS)) return;
+    size_t index = trajectorySweepCursor.fetch_add(1, std::memory_order_relaxed) % TRAJECTORY_SHARDS;
+    sweepTrajectoryShard(trajectoryShards[index], nowMs);
+}
+
+// Decodes userId's samples with fromMs <= timestamp <= toMs in order, calling
+// visit(const TrajectorySample&) for each. Aim angles come back in [0, 360).
+// Runs under the player's shard lock, so visitors should only accumulate.
+template <typename Visitor>
+void forEachTrajectorySample(const std::string& userId, long long fromMs, long long toMs, Visitor&& visit) {
+    TrajectoryShard& shard = trajectoryShard(userId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.players.find(userId);
+    if (it == shard.players.end()) return;
+
+    for (const TrajectoryChunk* chunk = it->second.head; chunk; chunk = chunk->next) {
+        if (chunk->lastTimestamp < fromMs) continue;
+        if (chunk->firstTimestamp > toMs) return;
+        TrajectoryCodec codec = trajectoryChunkCodec(*chunk);
+        TrajectoryBitReader in{chunk->data, sizeof(chunk->data)};
+        for (uint16_t i = 0; i < chunk->count; ++i) {
+            decodeTrajectorySample(codec, in);
+            if (codec.previous[0] < fromMs) continue;
+            if (codec.previous[0] > toMs) return;
+            visit(TrajectorySample{
+                codec.previous[0],
+                codec.previous[1] / TRAJECTORY_POSITION_SCALE,
+                codec.previous[2] / TRAJECTORY_POSITION_SCALE,
+                codec.previous[3] / TRAJECTORY_ANGLE_SCALE
+            });
+        }
+    }
+}
+
+// --- Detection event export ---
+//
+// addCheatLog hands every detection, with the player's numeric features, to a
+// background thread that appends columnar blocks (see LunorDetectionColumns.h)
+// to one file per UTC hour in the export directory. Nothing is queued until
+// startDetectionExporter is called, and a full queue drops events rather than
+// slowing validation.
+
+const long long DETECTION_EXPORT_FLUSH_MS = 5000;
+const size_t DETECTION_EXPORT_BLOCK_ROWS = 4096;
+const size_t DETECTION_EXPORT_MAX_PENDING = 1 << 16;
+
+struct DetectionExporter {
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::vector<DetectionEvent> pending;
+    std::thread worker;
+    std::string directory;
+    bool running = false;
+    std::atomic<bool> enabled{false};
+    std::atomic<unsigned long long> exported{0};
+    std::atomic<unsigned long long> dropped{0};
+    std::atomic<unsigned long long> writeFailures{0};
+
+    // Flushes everything queued so far and joins the export thread.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running) return;
+            enabled.store(false);
+            running = false;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    // A running exporter is flushed at static destruction rather than left joinable.
+    ~DetectionExporter() { stop(); }
+};
+
+DetectionExporter detectionExporter;
+
+std::string detectionExportPath(long long timestamp) {
+    std::time_t seconds = static_cast<std::time_t>(timestamp);
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    char name[32];
+    std::strftime(name, sizeof(name), "detections-%Y%m%d-%H.ldc", &utc);
+    return detectionExporter.directory + "/" + name;
+}
+
+// Splits a batch by the hour each event falls in and appends one block per hour file.
+void writeDetectionBatch(std::vector<DetectionEvent>& batch) {
+    std::stable_sort(batch.begin(), batch.end(), [](const DetectionEvent& a, const DetectionEvent& b) {
+        return a.timestamp / 3600 < b.timestamp / 3600;
+    });
+    std::vector<DetectionEvent> hour;
+    std::string encoded;
+    for (size_t begin = 0; begin < batch.size();) {
+        size_t end = begin;
+        while (end < batch.size() && batch[end].timestamp / 3600 == batch[begin].timestamp / 3600 &&
+               end - begin < DETECTION_EXPORT_BLOCK_ROWS) {
+            ++end;
+        }
+        hour.assign(std::make_move_iterator(batch.begin() + begin), std::make_move_iterator(batch.begin() + end));
+        encoded.clear();
+        encodeDetectionBlock(hour, encoded);
+
+        std::ofstream file(detectionExportPath(hour.front().timestamp), std::ios::binary | std::ios::app);
+        if (file.write(encoded.data(), static_cast<std::streamsize>(encoded.size()))) {
+            detectionExporter.exported.fetch_add(hour.size(), std::memory_order_relaxed);
+        } else {
+            detectionExporter.writeFailures.fetch_add(1, std::memory_order_relaxed);
+        }
+        begin = end;
+    }
+}
+
+void runDetectionExporter() {
+    std::vector<DetectionEvent> batch;
+    std::unique_lock<std::mutex> lock(detectionExporter.mutex);
+    while (true) {
+        detectionExporter.wake.wait_for(lock, std::chrono::milliseconds(DETECTION_EXPORT_FLUSH_MS), [] {
+            return !detectionExporter.running || detectionExporter.pending.size() >= DETECTION_EXPORT_BLOCK_ROWS;
+        });
+        bool stopping = !detectionExporter.running;
+        batch.swap(detectionExporter.pending);
+        lock.unlock();
+        if (!batch.empty()) writeDetectionBatch(batch);
+        batch.clear();
+        if (stopping) return;
+        lock.lock();
+    }
+}
+
+void startDetectionExporter(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(detectionExporter.mutex);
+    if (detectionExporter.running) return;
+    detectionExporter.directory = directory;
+    detectionExporter.running = true;
+    detectionExporter.enabled.store(true);
+    detectionExporter.worker = std::thread(runDetectionExporter);
+}
+
+// Flushes everything queued so far and joins the export thread.
+void stopDetectionExporter() {
+    detectionExporter.stop();
+}
+
+void exportDetection(const PlayerState& playerState, const std::string& cheatType, double severity, long long timestamp) {
+    if (!detectionExporter.enabled.load(std::memory_order_relaxed)) return;
+    bool flush = false;
+    {
+        std::lock_guard<std::mutex> lock(detectionExporter.mutex);
+        if (!detectionExporter.running) return;
+        if (detectionExporter.pending.size() >= DETECTION_EXPORT_MAX_PENDING) {
+            detectionExporter.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        detectionExporter.pending.push_back(DetectionEvent{
+            timestamp,
+            playerState.userId,
+            cheatType,
+            severity,
+            playerState.speed,
+            playerState.movementEntropy,
+            playerState.aimSmoothness,
+            playerState.serverTickDelta,
+            playerState.hitMissRatio,
+            playerState.suspiciousEventCount
+        });
+        flush = detectionExporter.pending.size() == DETECTION_EXPORT_BLOCK_ROWS;
+    }
+    if (flush) detectionExporter.wake.notify_one();
+}
+
 // --- Begin raw, non-AI anti-cheat logic expansion ---
 
 struct CheatDetectionLog {
@@ -249,16 +1560,21 @@ struct CheatDetectionLog {
 };
 
 std::vector<CheatDetectionLog> cheatLogs;
+std::mutex cheatLogsMutex;
 
-void addCheatLog(const std::string& userId, const std::string& cheatType, const std::string& details, double severity) {
+void addCheatLog(const PlayerState& playerState, const std::string& cheatType, const std::string& details, double severity) {
     CheatDetectionLog log;
-    log.userId = userId;
+    log.userId = playerState.userId;
     log.cheatType = cheatType;
     log.details = details;
     log.timestamp = std::time(nullptr);
     log.severity = severity;
-    cheatLogs.push_back(log);
-    logSuspicious(userId, cheatType, details);
+    {
+        std::lock_guard<std::mutex> lock(cheatLogsMutex);
+        cheatLogs.push_back(log);
+    }
+    exportDetection(playerState, cheatType, severity, log.timestamp);
+    logSuspicious(playerState.userId, cheatType, details);
 }
 
 void escalateBan(const PlayerState& playerState, const std::string& cheatType, double severity) {
@@ -299,10 +1615,8 @@ bool detectOverlayAbuse(const PlayerState& playerState) {
     return playerState.hasOverlay;
 }
 
-bool detectExternalTool(const PlayerState& playerState) {
-    std::string src = playerState.src;
-    std::transform(src.begin(), src.end(), src.begin(), ::tolower);
-    return src.find("modtool") != std::string::npos || src.find("trainer") != std::string::npos;
+bool detectExternalTool(std::string_view lowerSrc) {
+    return lowerSrc.find("modtool") != std::string_view::npos || lowerSrc.find("trainer") != std::string_view::npos;
 }
 
 bool detectScoreHack(const PlayerState& playerState) {
@@ -481,10 +1795,26 @@ ValidationResult validatePlayerAction(
     const std::string& actionType,
     const Payload& payload
 ) {
+    AdmissionDecision admission = admitAction(playerState);
+    if (admission == AdmissionDecision::FloodStarted) {
+        addCheatLog(playerState, "Action Flood", "hwid: " + playerState.hwid, 0.3);
+    }
+    if (admission == AdmissionDecision::FloodStarted || admission == AdmissionDecision::Throttled) {
+        return reject(ValidationCode::Throttled);
+    }
+
+    long long receivedMs = trajectoryNowMs();
+    recordTrajectory(playerState.userId, receivedMs,
+                     playerState.position.x, playerState.position.y, payload.aim.angle);
+    maybeSweepTrajectories(receivedMs);
+
+    scratchArena.reset();
+    std::string_view lowerSrc = toLowerScratch(playerState.src);
+
     if (playerState.speed > MAX_ALLOWED_SPEED || playerState.hasSpeedhack) {
-        addCheatLog(playerState.userId, "Speed Hack", "speed: " + std::to_string(playerState.speed), 1.0);
+        addCheatLog(playerState, "Speed Hack", "speed: " + std::to_string(playerState.speed), 1.0);
         escalateBan(playerState, "Speed Hack", 1.0);
-        return {false, "Speed hack detected. Action blocked."};
+        return reject(ValidationCode::SpeedHack);
     }
 
     double dist = std::sqrt(
@@ -492,301 +1822,306 @@ ValidationResult validatePlayerAction(
         std::pow(playerState.position.y - previousState.position.y, 2)
     );
     if (dist > MAX_ALLOWED_TELEPORT_DIST || detectTeleport(playerState, payload)) {
-        addCheatLog(playerState.userId, "Teleport/Position Tampering", "distance: " + std::to_string(dist), 1.0);
+        addCheatLog(playerState, "Teleport/Position Tampering", "distance: " + std::to_string(dist), 1.0);
         escalateBan(playerState, "Teleport/Position Tampering", 1.0);
-        return {false, "Teleport/position tampering detected."};
+        return reject(ValidationCode::Teleport);
+    }
+
+    if (!playerState.customPakVerified && isLunorCustomAllowed(lowerSrc)) {
+        addCheatLog(playerState, "Unverified Custom Pak", "src: " + playerState.src, 0.5);
+        return reject(ValidationCode::UnverifiedCustomPak);
     }
 
-    if (isBlockedSource(playerState.src)) {
-        addCheatLog(playerState.userId, "Blocked Client Source", "src: " + playerState.src, 1.0);
+    if (isBlockedSource(lowerSrc, playerState.customPakVerified)) {
+        addCheatLog(playerState, "Blocked Client Source", "src: " + playerState.src, 1.0);
         escalateBan(playerState, "Blocked Client Source", 1.0);
-        return {false, "Blocked client source: " + playerState.src};
+        return reject(ValidationCode::BlockedSource);
     }
 
     if (detectESPWallhack(playerState, payload)) {
-        addCheatLog(playerState.userId, "ESP/Wallhack/Injector/Overlay", "ESP/Wallhack/Injector/Overlay signals detected.", 1.0);
+        addCheatLog(playerState, "ESP/Wallhack/Injector/Overlay", "ESP/Wallhack/Injector/Overlay signals detected.", 1.0);
         escalateBan(playerState, "ESP/Wallhack/Injector/Overlay", 1.0);
-        return {false, "ESP/Wallhack/Injector/Overlay detected."};
+        return reject(ValidationCode::ESPWallhack);
     }
 
     if (detectAimbot(playerState, previousState, payload)) {
-        addCheatLog(playerState.userId, "Aimbot Detected", "aimData", 1.0);
+        addCheatLog(playerState, "Aimbot Detected", "aimData", 1.0);
         escalateBan(playerState, "Aimbot Detected", 1.0);
-        return {false, "Aimbot-like behavior detected."};
+        return reject(ValidationCode::Aimbot);
     }
 
     if (detectRapidFire(playerState, payload)) {
-        addCheatLog(playerState.userId, "Rapid Fire", "fireData", 1.0);
+        addCheatLog(playerState, "Rapid Fire", "fireData", 1.0);
         escalateBan(playerState, "Rapid Fire", 1.0);
-        return {false, "Rapid fire detected."};
+        return reject(ValidationCode::RapidFire);
     }
 
     if (detectItemDupe(playerState, payload)) {
-        addCheatLog(playerState.userId, "Item Duplication Cheat", "item dupe detected", 1.0);
+        addCheatLog(playerState, "Item Duplication Cheat", "item dupe detected", 1.0);
         escalateBan(playerState, "Item Duplication Cheat", 1.0);
-        return {false, "Item duplication cheat detected."};
+        return reject(ValidationCode::ItemDupe);
     }
 
     if (detectPacketForge(playerState, payload)) {
-        addCheatLog(playerState.userId, "Packet Forging", "packet forging detected", 1.0);
+        addCheatLog(playerState, "Packet Forging", "packet forging detected", 1.0);
         escalateBan(playerState, "Packet Forging", 1.0);
-        return {false, "Packet forging detected."};
+        return reject(ValidationCode::PacketForge);
     }
 
     if (detectMemoryTamper(playerState, payload)) {
-        addCheatLog(playerState.userId, "Memory Tampering", "memory tampering detected", 1.0);
+        addCheatLog(playerState, "Memory Tampering", "memory tampering detected", 1.0);
         escalateBan(playerState, "Memory Tampering", 1.0);
-        return {false, "Memory tampering detected."};
+        return reject(ValidationCode::MemoryTamper);
     }
 
     if (isHWIDBanned(playerState.hwid)) {
-        addCheatLog(playerState.userId, "HWID Ban", "hwid: " + playerState.hwid, 1.0);
+        addCheatLog(playerState, "HWID Ban", "hwid: " + playerState.hwid, 1.0);
         escalateBan(playerState, "HWID Ban", 1.0);
-        return {false, "Device banned."};
+        return reject(ValidationCode::HWIDBanned);
     }
 
     // Additional raw checks for expanded anti-cheat coverage
     if (checkMovementEntropy(playerState)) {
-        addCheatLog(playerState.userId, "Low Movement Entropy", "entropy: " + std::to_string(playerState.movementEntropy), 0.7);
+        addCheatLog(playerState, "Low Movement Entropy", "entropy: " + std::to_string(playerState.movementEntropy), 0.7);
     }
     if (checkAimSmoothness(playerState)) {
-        addCheatLog(playerState.userId, "Low Aim Smoothness", "smoothness: " + std::to_string(playerState.aimSmoothness), 0.7);
+        addCheatLog(playerState, "Low Aim Smoothness", "smoothness: " + std::to_string(playerState.aimSmoothness), 0.7);
     }
     if (checkHitMissRatio(playerState)) {
-        addCheatLog(playerState.userId, "Suspicious Hit/Miss Ratio", "ratio: " + std::to_string(playerState.hitMissRatio), 0.6);
+        addCheatLog(playerState, "Suspicious Hit/Miss Ratio", "ratio: " + std::to_string(playerState.hitMissRatio), 0.6);
     }
     if (checkServerTickDelta(playerState)) {
-        addCheatLog(playerState.userId, "Server Tick Delta", "tickDelta: " + std::to_string(playerState.serverTickDelta), 0.5);
+        addCheatLog(playerState, "Server Tick Delta", "tickDelta: " + std::to_string(playerState.serverTickDelta), 0.5);
     }
     if (excessiveSuspiciousEvents(playerState)) {
-        addCheatLog(playerState.userId, "Excessive Suspicious Events", "count: " + std::to_string(playerState.suspiciousEventCount), 0.8);
+        addCheatLog(playerState, "Excessive Suspicious Events", "count: " + std::to_string(playerState.suspiciousEventCount), 0.8);
     }
     if (abnormalIP(playerState.ipAddress)) {
-        addCheatLog(playerState.userId, "Abnormal IP Address", "ip: " + playerState.ipAddress, 0.5);
+        addCheatLog(playerState, "Abnormal IP Address", "ip: " + playerState.ipAddress, 0.5);
     }
     if (abnormalSession(playerState.sessionId)) {
-        addCheatLog(playerState.userId, "Abnormal Session ID", "session: " + playerState.sessionId, 0.5);
+        addCheatLog(playerState, "Abnormal Session ID", "session: " + playerState.sessionId, 0.5);
     }
     if (detectOverlayAbuse(playerState)) {
-        addCheatLog(playerState.userId, "Overlay Abuse", "overlay detected", 1.0);
+        addCheatLog(playerState, "Overlay Abuse", "overlay detected", 1.0);
         escalateBan(playerState, "Overlay Abuse", 1.0);
-        return {false, "Overlay abuse detected."};
+        return reject(ValidationCode::OverlayAbuse);
     }
-    if (detectExternalTool(playerState)) {
-        addCheatLog(playerState.userId, "External Tool", "modtool/trainer detected", 1.0);
+    if (detectExternalTool(lowerSrc)) {
+        addCheatLog(playerState, "External Tool", "modtool/trainer detected", 1.0);
         escalateBan(playerState, "External Tool", 1.0);
-        return {false, "External tool detected."};
+        return reject(ValidationCode::ExternalTool);
     }
     if (detectScoreHack(playerState)) {
-        addCheatLog(playerState.userId, "Score Hack", "scorehack detected", 1.0);
+        addCheatLog(playerState, "Score Hack", "scorehack detected", 1.0);
         escalateBan(playerState, "Score Hack", 1.0);
-        return {false, "Score hack detected."};
+        return reject(ValidationCode::ScoreHack);
     }
     if (detectMoneyHack(playerState)) {
-        addCheatLog(playerState.userId, "Money Hack", "moneyhack detected", 1.0);
+        addCheatLog(playerState, "Money Hack", "moneyhack detected", 1.0);
         escalateBan(playerState, "Money Hack", 1.0);
-        return {false, "Money hack detected."};
+        return reject(ValidationCode::MoneyHack);
     }
     if (detectSuperjump(playerState)) {
-        addCheatLog(playerState.userId, "Superjump", "superjump detected", 1.0);
+        addCheatLog(playerState, "Superjump", "superjump detected", 1.0);
         escalateBan(playerState, "Superjump", 1.0);
-        return {false, "Superjump detected."};
+        return reject(ValidationCode::Superjump);
     }
     if (detectSuperrun(playerState)) {
-        addCheatLog(playerState.userId, "Superrun", "superrun detected", 1.0);
+        addCheatLog(playerState, "Superrun", "superrun detected", 1.0);
         escalateBan(playerState, "Superrun", 1.0);
-        return {false, "Superrun detected."};
+        return reject(ValidationCode::Superrun);
     }
     if (detectModMenu(playerState)) {
-        addCheatLog(playerState.userId, "Mod Menu", "modmenu detected", 1.0);
+        addCheatLog(playerState, "Mod Menu", "modmenu detected", 1.0);
         escalateBan(playerState, "Mod Menu", 1.0);
-        return {false, "Mod Menu detected."};
+        return reject(ValidationCode::ModMenu);
     }
     if (detectOverlayMod(playerState)) {
-        addCheatLog(playerState.userId, "Overlay Mod", "overlaymod detected", 1.0);
+        addCheatLog(playerState, "Overlay Mod", "overlaymod detected", 1.0);
         escalateBan(playerState, "Overlay Mod", 1.0);
-        return {false, "Overlay Mod detected."};
+        return reject(ValidationCode::OverlayMod);
     }
     if (detectOverlayDLL(playerState)) {
-        addCheatLog(playerState.userId, "Overlay DLL", "overlaydll detected", 1.0);
+        addCheatLog(playerState, "Overlay DLL", "overlaydll detected", 1.0);
         escalateBan(playerState, "Overlay DLL", 1.0);
-        return {false, "Overlay DLL detected."};
+        return reject(ValidationCode::OverlayDLL);
     }
     if (detectHookDLL(playerState)) {
-        addCheatLog(playerState.userId, "Hook DLL", "hookdll detected", 1.0);
+        addCheatLog(playerState, "Hook DLL", "hookdll detected", 1.0);
         escalateBan(playerState, "Hook DLL", 1.0);
-        return {false, "Hook DLL detected."};
+        return reject(ValidationCode::HookDLL);
     }
     if (detectForceKick(playerState)) {
-        addCheatLog(playerState.userId, "Force Kick", "forcekick detected", 1.0);
+        addCheatLog(playerState, "Force Kick", "forcekick detected", 1.0);
         escalateBan(playerState, "Force Kick", 1.0);
-        return {false, "Force Kick detected."};
+        return reject(ValidationCode::ForceKick);
     }
     if (detectCrashServer(playerState)) {
-        addCheatLog(playerState.userId, "Crash Server", "crashserver detected", 1.0);
+        addCheatLog(playerState, "Crash Server", "crashserver detected", 1.0);
         escalateBan(playerState, "Crash Server", 1.0);
-        return {false, "Crash Server detected."};
+        return reject(ValidationCode::CrashServer);
     }
     if (detectSpoof(playerState)) {
-        addCheatLog(playerState.userId, "Spoof", "spoof detected", 1.0);
+        addCheatLog(playerState, "Spoof", "spoof detected", 1.0);
         escalateBan(playerState, "Spoof", 1.0);
-        return {false, "Spoof detected."};
+        return reject(ValidationCode::Spoof);
     }
     if (detectFovChanger(playerState)) {
-        addCheatLog(playerState.userId, "FOV Changer", "fovchanger detected", 1.0);
+        addCheatLog(playerState, "FOV Changer", "fovchanger detected", 1.0);
         escalateBan(playerState, "FOV Changer", 1.0);
-        return {false, "FOV Changer detected."};
+        return reject(ValidationCode::FovChanger);
     }
     if (detectSkinChanger(playerState)) {
-        addCheatLog(playerState.userId, "Skin Changer", "skinchanger detected", 1.0);
+        addCheatLog(playerState, "Skin Changer", "skinchanger detected", 1.0);
         escalateBan(playerState, "Skin Changer", 1.0);
-        return {false, "Skin Changer detected."};
+        return reject(ValidationCode::SkinChanger);
     }
     if (detectInventoryHack(playerState)) {
-        addCheatLog(playerState.userId, "Inventory Hack", "inventoryhack detected", 1.0);
+        addCheatLog(playerState, "Inventory Hack", "inventoryhack detected", 1.0);
         escalateBan(playerState, "Inventory Hack", 1.0);
-        return {false, "Inventory Hack detected."};
+        return reject(ValidationCode::InventoryHack);
     }
     if (detectGlowESP(playerState)) {
-        addCheatLog(playerState.userId, "Glow ESP", "glowesp detected", 1.0);
+        addCheatLog(playerState, "Glow ESP", "glowesp detected", 1.0);
         escalateBan(playerState, "Glow ESP", 1.0);
-        return {false, "Glow ESP detected."};
+        return reject(ValidationCode::GlowESP);
     }
     if (detectChams(playerState)) {
-        addCheatLog(playerState.userId, "Chams", "chams detected", 1.0);
+        addCheatLog(playerState, "Chams", "chams detected", 1.0);
         escalateBan(playerState, "Chams", 1.0);
-        return {false, "Chams detected."};
+        return reject(ValidationCode::Chams);
     }
     if (detectBacktrack(playerState)) {
-        addCheatLog(playerState.userId, "Backtrack", "backtrack detected", 1.0);
+        addCheatLog(playerState, "Backtrack", "backtrack detected", 1.0);
         escalateBan(playerState, "Backtrack", 1.0);
-        return {false, "Backtrack detected."};
+        return reject(ValidationCode::Backtrack);
     }
     if (detectHitboxExpander(playerState)) {
-        addCheatLog(playerState.userId, "Hitbox Expander", "hitboxexpander detected", 1.0);
+        addCheatLog(playerState, "Hitbox Expander", "hitboxexpander detected", 1.0);
         escalateBan(playerState, "Hitbox Expander", 1.0);
-        return {false, "Hitbox Expander detected."};
+        return reject(ValidationCode::HitboxExpander);
     }
     if (detectTeleportHack(playerState)) {
-        addCheatLog(playerState.userId, "Teleport Hack", "teleporthack detected", 1.0);
+        addCheatLog(playerState, "Teleport Hack", "teleporthack detected", 1.0);
         escalateBan(playerState, "Teleport Hack", 1.0);
-        return {false, "Teleport Hack detected."};
+        return reject(ValidationCode::TeleportHack);
     }
     if (detectNoclip(playerState)) {
-        addCheatLog(playerState.userId, "Noclip", "noclip detected", 1.0);
+        addCheatLog(playerState, "Noclip", "noclip detected", 1.0);
         escalateBan(playerState, "Noclip", 1.0);
-        return {false, "Noclip detected."};
+        return reject(ValidationCode::Noclip);
     }
     if (detectGodmode(playerState)) {
-        addCheatLog(playerState.userId, "Godmode", "godmode detected", 1.0);
+        addCheatLog(playerState, "Godmode", "godmode detected", 1.0);
         escalateBan(playerState, "Godmode", 1.0);
-        return {false, "Godmode detected."};
+        return reject(ValidationCode::Godmode);
     }
     if (detectRadarHack(playerState)) {
-        addCheatLog(playerState.userId, "Radar Hack", "radarhack detected", 1.0);
+        addCheatLog(playerState, "Radar Hack", "radarhack detected", 1.0);
         escalateBan(playerState, "Radar Hack", 1.0);
-        return {false, "Radar Hack detected."};
+        return reject(ValidationCode::RadarHack);
     }
     if (detectTriggerBot(playerState)) {
-        addCheatLog(playerState.userId, "Trigger Bot", "triggerbot detected", 1.0);
+        addCheatLog(playerState, "Trigger Bot", "triggerbot detected", 1.0);
         escalateBan(playerState, "Trigger Bot", 1.0);
-        return {false, "Trigger Bot detected."};
+        return reject(ValidationCode::TriggerBot);
     }
     if (detectAutoClicker(playerState)) {
-        addCheatLog(playerState.userId, "Auto Clicker", "autoclicker detected", 1.0);
+        addCheatLog(playerState, "Auto Clicker", "autoclicker detected", 1.0);
         escalateBan(playerState, "Auto Clicker", 1.0);
-        return {false, "Auto Clicker detected."};
+        return reject(ValidationCode::AutoClicker);
     }
     if (detectMacro(playerState)) {
-        addCheatLog(playerState.userId, "Macro", "macro detected", 1.0);
+        addCheatLog(playerState, "Macro", "macro detected", 1.0);
         escalateBan(playerState, "Macro", 1.0);
-        return {false, "Macro detected."};
+        return reject(ValidationCode::Macro);
     }
     if (detectRecoilScript(playerState)) {
-        addCheatLog(playerState.userId, "Recoil Script", "recoilscript detected", 1.0);
+        addCheatLog(playerState, "Recoil Script", "recoilscript detected", 1.0);
         escalateBan(playerState, "Recoil Script", 1.0);
-        return {false, "Recoil Script detected."};
+        return reject(ValidationCode::RecoilScript);
     }
     if (detectAntiRecoil(playerState)) {
-        addCheatLog(playerState.userId, "Anti Recoil", "antirecoil detected", 1.0);
+        addCheatLog(playerState, "Anti Recoil", "antirecoil detected", 1.0);
         escalateBan(playerState, "Anti Recoil", 1.0);
-        return {false, "Anti Recoil detected."};
+        return reject(ValidationCode::AntiRecoil);
     }
     if (detectBypass(playerState)) {
-        addCheatLog(playerState.userId, "Bypass", "bypass detected", 1.0);
+        addCheatLog(playerState, "Bypass", "bypass detected", 1.0);
         escalateBan(playerState, "Bypass", 1.0);
-        return {false, "Bypass detected."};
+        return reject(ValidationCode::Bypass);
     }
     if (detectCheatEngine(playerState)) {
-        addCheatLog(playerState.userId, "Cheat Engine", "cheatengine detected", 1.0);
+        addCheatLog(playerState, "Cheat Engine", "cheatengine detected", 1.0);
         escalateBan(playerState, "Cheat Engine", 1.0);
-        return {false, "Cheat Engine detected."};
+        return reject(ValidationCode::CheatEngine);
     }
     if (detectLuaExecutor(playerState)) {
-        addCheatLog(playerState.userId, "Lua Executor", "luaexecutor detected", 1.0);
+        addCheatLog(playerState, "Lua Executor", "luaexecutor detected", 1.0);
         escalateBan(playerState, "Lua Executor", 1.0);
-        return {false, "Lua Executor detected."};
+        return reject(ValidationCode::LuaExecutor);
     }
     if (detectPythonInject(playerState)) {
-        addCheatLog(playerState.userId, "Python Inject", "pythoninject detected", 1.0);
+        addCheatLog(playerState, "Python Inject", "pythoninject detected", 1.0);
         escalateBan(playerState, "Python Inject", 1.0);
-        return {false, "Python Inject detected."};
+        return reject(ValidationCode::PythonInject);
     }
     if (detectExternalOverlay(playerState)) {
-        addCheatLog(playerState.userId, "External Overlay", "externaloverlay detected", 1.0);
+        addCheatLog(playerState, "External Overlay", "externaloverlay detected", 1.0);
         escalateBan(playerState, "External Overlay", 1.0);
-        return {false, "External Overlay detected."};
+        return reject(ValidationCode::ExternalOverlay);
     }
     if (detectMinimap(playerState)) {
-        addCheatLog(playerState.userId, "Minimap", "minimap detected", 1.0);
+        addCheatLog(playerState, "Minimap", "minimap detected", 1.0);
         escalateBan(playerState, "Minimap", 1.0);
-        return {false, "Minimap detected."};
+        return reject(ValidationCode::Minimap);
     }
     if (detectStatChanger(playerState)) {
-        addCheatLog(playerState.userId, "Stat Changer", "statchanger detected", 1.0);
+        addCheatLog(playerState, "Stat Changer", "statchanger detected", 1.0);
         escalateBan(playerState, "Stat Changer", 1.0);
-        return {false, "Stat Changer detected."};
+        return reject(ValidationCode::StatChanger);
     }
     if (detectDamageHack(playerState)) {
-        addCheatLog(playerState.userId, "Damage Hack", "damagehack detected", 1.0);
+        addCheatLog(playerState, "Damage Hack", "damagehack detected", 1.0);
         escalateBan(playerState, "Damage Hack", 1.0);
-        return {false, "Damage Hack detected."};
+        return reject(ValidationCode::DamageHack);
     }
     if (detectDropHack(playerState)) {
-        addCheatLog(playerState.userId, "Drop Hack", "drophack detected", 1.0);
+        addCheatLog(playerState, "Drop Hack", "drophack detected", 1.0);
         escalateBan(playerState, "Drop Hack", 1.0);
-        return {false, "Drop Hack detected."};
+        return reject(ValidationCode::DropHack);
     }
     if (detectXPBoost(playerState)) {
-        addCheatLog(playerState.userId, "XP Boost", "xpboost detected", 1.0);
+        addCheatLog(playerState, "XP Boost", "xpboost detected", 1.0);
         escalateBan(playerState, "XP Boost", 1.0);
-        return {false, "XP Boost detected."};
+        return reject(ValidationCode::XPBoost);
     }
     if (detectDLLHack(playerState)) {
-        addCheatLog(playerState.userId, "DLL Hack", "dllhack detected", 1.0);
+        addCheatLog(playerState, "DLL Hack", "dllhack detected", 1.0);
         escalateBan(playerState, "DLL Hack", 1.0);
-        return {false, "DLL Hack detected."};
+        return reject(ValidationCode::DLLHack);
     }
     if (detectOverlayCheat(playerState)) {
-        addCheatLog(playerState.userId, "Overlay Cheat", "overlaycheat detected", 1.0);
+        addCheatLog(playerState, "Overlay Cheat", "overlaycheat detected", 1.0);
         escalateBan(playerState, "Overlay Cheat", 1.0);
-        return {false, "Overlay Cheat detected."};
+        return reject(ValidationCode::OverlayCheat);
     }
     if (detectSilentAim(playerState)) {
-        addCheatLog(playerState.userId, "Silent Aim", "silentaim detected", 1.0);
+        addCheatLog(playerState, "Silent Aim", "silentaim detected", 1.0);
         escalateBan(playerState, "Silent Aim", 1.0);
-        return {false, "Silent Aim detected."};
+        return reject(ValidationCode::SilentAim);
     }
     if (detectSpinBot(playerState)) {
-        addCheatLog(playerState.userId, "Spin Bot", "spinbot detected", 1.0);
+        addCheatLog(playerState, "Spin Bot", "spinbot detected", 1.0);
         escalateBan(playerState, "Spin Bot", 1.0);
-        return {false, "Spin Bot detected."};
+        return reject(ValidationCode::SpinBot);
     }
     if (detectFlyHack(playerState)) {
-        addCheatLog(playerState.userId, "Fly Hack", "flyhack detected", 1.0);
+        addCheatLog(playerState, "Fly Hack", "flyhack detected", 1.0);
         escalateBan(playerState, "Fly Hack", 1.0);
-        return {false, "Fly Hack detected."};
+        return reject(ValidationCode::FlyHack);
     }
 
-    return {true, ""};
+    return {true, ValidationCode::Ok, validationReasonText(ValidationCode::Ok)};
 }
\ No newline at end of file
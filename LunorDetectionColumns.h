@@ -0,0 +1,485 @@
+#pragma once
+
+// Columnar on-disk format for exported detection events, shared by the
+// exporter in LunorAntiCheat.cpp and the offline scanner in analytics/.
+//
+// A file is a sequence of independently decodable blocks:
+//
+//   "LDC3" | payloadLength u32 | payload CRC-32 u32 | payload
+//   payload: rowCount u32 | columnCount u32 | per column: byteLength u32, bytes
+//
+// Blocks are appended, so a crash mid-write leaves a torn block that later
+// appends follow. The reader skips any block whose length or CRC does not check
+// out and resyncs on the next magic, losing only the damaged bytes.
+//
+// Category columns (userId, cheatType) are dictionary encoded per block: a
+// varint dictionary size, then varint-length-prefixed strings, then one varint
+// code per row. Integer columns are zigzag varint deltas from the previous row.
+//
+// Double columns start with a mode byte. A column with at most
+// DETECTION_DOUBLE_DICTIONARY_LIMIT distinct values (severity, fixed-threshold
+// features) may be dictionary encoded: a varint dictionary size, the raw 8-byte
+// values, a code width byte, then one bit-packed code per row. Otherwise each
+// value is XORed with the previous row's bits and written Gorilla-style: a zero
+// bit for a repeat, or the meaningful bits between the leading and trailing
+// zeros, reusing the previous window when they fit inside it. The encoder keeps
+// whichever mode is smaller.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+const char DETECTION_BLOCK_MAGIC[4] = {'L', 'D', 'C', '3'};
+const size_t DETECTION_BLOCK_HEADER_BYTES = 12;
+const uint32_t DETECTION_COLUMN_COUNT = 10;
+const size_t DETECTION_DOUBLE_DICTIONARY_LIMIT = 256;
+
+enum class DoubleColumnMode : unsigned char {
+    Xor,
+    Dictionary
+};
+
+struct DetectionEvent {
+    long long timestamp;
+    std::string userId;
+    std::string cheatType;
+    double severity;
+    double speed;
+    double movementEntropy;
+    double aimSmoothness;
+    double serverTickDelta;
+    double hitMissRatio;
+    long long suspiciousEventCount;
+};
+
+// One decoded block, column by column, ready for tight loops over the arrays.
+struct DetectionBlock {
+    size_t rows = 0;
+    std::vector<long long> timestamp;
+    std::vector<std::string> userDictionary;
+    std::vector<uint32_t> userCode;
+    std::vector<std::string> typeDictionary;
+    std::vector<uint32_t> typeCode;
+    std::vector<double> severity;
+    std::vector<double> speed;
+    std::vector<double> movementEntropy;
+    std::vector<double> aimSmoothness;
+    std::vector<double> serverTickDelta;
+    std::vector<double> hitMissRatio;
+    std::vector<long long> suspiciousEventCount;
+};
+
+inline void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+inline bool getVarint(const unsigned char*& in, const unsigned char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; in < end && shift < 64; shift += 7) {
+        unsigned char byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// Appends bits most significant first, padding the last byte with zeros.
+struct DetectionBitWriter {
+    std::string& out;
+    uint64_t pending = 0;
+    unsigned pendingBits = 0;
+
+    explicit DetectionBitWriter(std::string& target) : out(target) {}
+
+    void put(uint64_t value, unsigned bits) {
+        if (bits > 32) {
+            put(value >> 32, bits - 32);
+            bits = 32;
+        }
+        if (bits == 0) return;
+        pending = (pending << bits) | (value & (~uint64_t(0) >> (64 - bits)));
+        pendingBits += bits;
+        while (pendingBits >= 8) {
+            pendingBits -= 8;
+            out += static_cast<char>(pending >> pendingBits);
+        }
+    }
+
+    void finish() {
+        if (pendingBits > 0) out += static_cast<char>(pending << (8 - pendingBits));
+        pendingBits = 0;
+    }
+};
+
+struct DetectionBitReader {
+    const unsigned char* in;
+    const unsigned char* end;
+    uint64_t buffer = 0;
+    unsigned bufferBits = 0;
+
+    bool get(unsigned bits, uint64_t& value) {
+        if (bits > 32) {
+            uint64_t high;
+            if (!get(bits - 32, high) || !get(32, value)) return false;
+            value |= high << 32;
+            return true;
+        }
+        while (bufferBits < bits) {
+            if (in == end) return false;
+            buffer = (buffer << 8) | *in++;
+            bufferBits += 8;
+        }
+        bufferBits -= bits;
+        value = bits == 0 ? 0 : (buffer >> bufferBits) & (~uint64_t(0) >> (64 - bits));
+        return true;
+    }
+};
+
+// CRC-32 (IEEE 802.3, reflected, as in zlib) of size bytes.
+inline uint32_t detectionCrc32(const unsigned char* data, size_t size) {
+    struct Table {
+        uint32_t entries[256];
+        Table() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (0xEDB88320u & (~(crc & 1) + 1));
+                entries[i] = crc;
+            }
+        }
+    };
+    static const Table table;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) crc = (crc >> 8) ^ table.entries[(crc ^ data[i]) & 0xFF];
+    return ~crc;
+}
+
+inline void putU32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out += static_cast<char>(value >> (i * 8));
+}
+
+inline void setU32(std::string& out, size_t offset, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out[offset + i] = static_cast<char>(value >> (i * 8));
+}
+
+inline uint32_t getU32(const unsigned char* in) {
+    return uint32_t(in[0]) | (uint32_t(in[1]) << 8) | (uint32_t(in[2]) << 16) | (uint32_t(in[3]) << 24);
+}
+
+template <typename Field>
+void encodeIntColumn(const std::vector<DetectionEvent>& events, Field field, std::string& out) {
+    long long previous = 0;
+    for (const auto& event : events) {
+        long long delta = static_cast<long long>(static_cast<uint64_t>(event.*field) - static_cast<uint64_t>(previous));
+        putVarint(out, (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+        previous = event.*field;
+    }
+}
+
+inline uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+template <typename Field>
+void encodeXorDoubleColumn(const std::vector<DetectionEvent>& events, Field field, std::string& out) {
+    out += static_cast<char>(DoubleColumnMode::Xor);
+    DetectionBitWriter writer(out);
+    uint64_t previous = 0;
+    unsigned leading = 64;
+    unsigned trailing = 0;
+    for (const auto& event : events) {
+        uint64_t bits = doubleBits(event.*field);
+        uint64_t xored = bits ^ previous;
+        previous = bits;
+        if (xored == 0) {
+            writer.put(0, 1);
+            continue;
+        }
+        // Leading zeros are capped to fit their 5-bit field.
+        unsigned valueLeading = std::min(static_cast<unsigned>(__builtin_clzll(xored)), 31u);
+        unsigned valueTrailing = static_cast<unsigned>(__builtin_ctzll(xored));
+        if (leading != 64 && valueLeading >= leading && valueTrailing >= trailing) {
+            writer.put(0b10, 2);
+            writer.put(xored >> trailing, 64 - leading - trailing);
+            continue;
+        }
+        leading = valueLeading;
+        trailing = valueTrailing;
+        unsigned meaningful = 64 - leading - trailing;
+        writer.put(0b11, 2);
+        writer.put(leading, 5);
+        writer.put(meaningful - 1, 6);
+        writer.put(xored >> trailing, meaningful);
+    }
+    writer.finish();
+}
+
+// Returns false without writing when the column has more than
+// DETECTION_DOUBLE_DICTIONARY_LIMIT distinct values. Values are keyed on their
+// bits, so -0.0 and NaN payloads survive the round trip.
+template <typename Field>
+bool encodeDictionaryDoubleColumn(const std::vector<DetectionEvent>& events, Field field, std::string& out) {
+    std::unordered_map<uint64_t, uint32_t> codes;
+    std::vector<uint64_t> dictionary;
+    std::vector<uint32_t> rowCodes;
+    rowCodes.reserve(events.size());
+    for (const auto& event : events) {
+        uint64_t bits = doubleBits(event.*field);
+        auto inserted = codes.emplace(bits, static_cast<uint32_t>(dictionary.size()));
+        if (inserted.second) {
+            if (dictionary.size() == DETECTION_DOUBLE_DICTIONARY_LIMIT) return false;
+            dictionary.push_back(bits);
+        }
+        rowCodes.push_back(inserted.first->second);
+    }
+    unsigned width = 0;
+    while ((size_t(1) << width) < dictionary.size()) ++width;
+
+    out += static_cast<char>(DoubleColumnMode::Dictionary);
+    putVarint(out, dictionary.size());
+    for (uint64_t bits : dictionary) {
+        for (int i = 0; i < 8; ++i) out += static_cast<char>(bits >> (i * 8));
+    }
+    out += static_cast<char>(width);
+    DetectionBitWriter writer(out);
+    for (uint32_t code : rowCodes) writer.put(code, width);
+    writer.finish();
+    return true;
+}
+
+template <typename Field>
+void encodeDoubleColumn(const std::vector<DetectionEvent>& events, Field field, std::string& out) {
+    encodeXorDoubleColumn(events, field, out);
+    std::string dictionary;
+    if (encodeDictionaryDoubleColumn(events, field, dictionary) && dictionary.size() < out.size()) out.swap(dictionary);
+}
+
+template <typename Field>
+void encodeDictionaryColumn(const std::vector<DetectionEvent>& events, Field field, std::string& out) {
+    std::unordered_map<std::string, uint32_t> codes;
+    std::vector<const std::string*> dictionary;
+    std::string rowCodes;
+    for (const auto& event : events) {
+        auto inserted = codes.emplace(event.*field, static_cast<uint32_t>(dictionary.size()));
+        if (inserted.second) dictionary.push_back(&inserted.first->first);
+        putVarint(rowCodes, inserted.first->second);
+    }
+    putVarint(out, dictionary.size());
+    for (const std::string* value : dictionary) {
+        putVarint(out, value->size());
+        out += *value;
+    }
+    out += rowCodes;
+}
+
+inline void encodeDetectionBlock(const std::vector<DetectionEvent>& events, std::string& out) {
+    std::vector<std::string> columns(DETECTION_COLUMN_COUNT);
+    encodeIntColumn(events, &DetectionEvent::timestamp, columns[0]);
+    encodeDictionaryColumn(events, &DetectionEvent::userId, columns[1]);
+    encodeDictionaryColumn(events, &DetectionEvent::cheatType, columns[2]);
+    encodeDoubleColumn(events, &DetectionEvent::severity, columns[3]);
+    encodeDoubleColumn(events, &DetectionEvent::speed, columns[4]);
+    encodeDoubleColumn(events, &DetectionEvent::movementEntropy, columns[5]);
+    encodeDoubleColumn(events, &DetectionEvent::aimSmoothness, columns[6]);
+    encodeDoubleColumn(events, &DetectionEvent::serverTickDelta, columns[7]);
+    encodeDoubleColumn(events, &DetectionEvent::hitMissRatio, columns[8]);
+    encodeIntColumn(events, &DetectionEvent::suspiciousEventCount, columns[9]);
+
+    size_t header = out.size();
+    out.append(DETECTION_BLOCK_MAGIC, sizeof(DETECTION_BLOCK_MAGIC));
+    putU32(out, 0);  // payloadLength and CRC, filled in once the payload is written
+    putU32(out, 0);
+    size_t payload = out.size();
+    putU32(out, static_cast<uint32_t>(events.size()));
+    putU32(out, DETECTION_COLUMN_COUNT);
+    for (const auto& column : columns) {
+        putU32(out, static_cast<uint32_t>(column.size()));
+        out += column;
+    }
+
+    size_t payloadLength = out.size() - payload;
+    setU32(out, header + 4, static_cast<uint32_t>(payloadLength));
+    setU32(out, header + 8, detectionCrc32(reinterpret_cast<const unsigned char*>(out.data()) + payload, payloadLength));
+}
+
+inline bool decodeIntColumn(const unsigned char* in, const unsigned char* end, size_t rows, std::vector<long long>& out) {
+    out.resize(rows);
+    uint64_t previous = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        uint64_t zigzag;
+        if (!getVarint(in, end, zigzag)) return false;
+        previous += (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+        out[i] = static_cast<long long>(previous);
+    }
+    return true;
+}
+
+inline bool decodeXorDoubleColumn(const unsigned char* in, const unsigned char* end, size_t rows, std::vector<double>& out) {
+    DetectionBitReader reader{in, end};
+    uint64_t previous = 0;
+    unsigned leading = 64;
+    unsigned trailing = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        uint64_t control;
+        if (!reader.get(1, control)) return false;
+        if (control) {
+            if (!reader.get(1, control)) return false;
+            if (control) {
+                uint64_t newLeading, meaningful;
+                if (!reader.get(5, newLeading) || !reader.get(6, meaningful)) return false;
+                if (newLeading + meaningful + 1 > 64) return false;
+                leading = static_cast<unsigned>(newLeading);
+                trailing = 64 - leading - static_cast<unsigned>(meaningful + 1);
+            } else if (leading == 64) {
+                return false;
+            }
+            uint64_t xored;
+            if (!reader.get(64 - leading - trailing, xored)) return false;
+            previous ^= xored << trailing;
+        }
+        std::memcpy(&out[i], &previous, sizeof(previous));
+    }
+    return true;
+}
+
+inline bool decodeDictionaryDoubleColumn(const unsigned char* in, const unsigned char* end, size_t rows,
+                                         std::vector<double>& out) {
+    uint64_t size;
+    if (!getVarint(in, end, size) || size == 0 || size > DETECTION_DOUBLE_DICTIONARY_LIMIT ||
+        size * 8 + 1 > static_cast<uint64_t>(end - in)) {
+        return false;
+    }
+    double dictionary[DETECTION_DOUBLE_DICTIONARY_LIMIT];
+    for (uint64_t i = 0; i < size; ++i, in += 8) {
+        uint64_t bits = uint64_t(getU32(in)) | (uint64_t(getU32(in + 4)) << 32);
+        std::memcpy(&dictionary[i], &bits, sizeof(bits));
+    }
+    unsigned width = *in++;
+    if (width > 8) return false;
+    DetectionBitReader reader{in, end};
+    for (size_t i = 0; i < rows; ++i) {
+        uint64_t code;
+        if (!reader.get(width, code) || code >= size) return false;
+        out[i] = dictionary[code];
+    }
+    return true;
+}
+
+inline bool decodeDoubleColumn(const unsigned char* in, const unsigned char* end, size_t rows, std::vector<double>& out) {
+    out.resize(rows);
+    if (in == end) return false;
+    DoubleColumnMode mode = static_cast<DoubleColumnMode>(*in++);
+    if (mode == DoubleColumnMode::Xor) return decodeXorDoubleColumn(in, end, rows, out);
+    if (mode == DoubleColumnMode::Dictionary) return decodeDictionaryDoubleColumn(in, end, rows, out);
+    return false;
+}
+
+inline bool decodeDictionaryColumn(const unsigned char* in, const unsigned char* end, size_t rows,
+                                   std::vector<std::string>& dictionary, std::vector<uint32_t>& codes) {
+    uint64_t size;
+    if (!getVarint(in, end, size) || size > static_cast<uint64_t>(end - in)) return false;
+    dictionary.resize(size);
+    for (auto& value : dictionary) {
+        uint64_t length;
+        if (!getVarint(in, end, length) || length > static_cast<uint64_t>(end - in)) return false;
+        value.assign(reinterpret_cast<const char*>(in), length);
+        in += length;
+    }
+    codes.resize(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        uint64_t code;
+        if (!getVarint(in, end, code) || code >= size) return false;
+        codes[i] = static_cast<uint32_t>(code);
+    }
+    return true;
+}
+
+// Splits a block payload into its columns. Returns false if the header or the
+// column lengths do not fit the payload.
+inline bool splitDetectionColumns(const unsigned char* in, const unsigned char* end, size_t& rows,
+                                  const unsigned char* columns[], const unsigned char* columnEnds[]) {
+    if (end - in < 8) return false;
+    rows = getU32(in);
+    uint32_t columnCount = getU32(in + 4);
+    in += 8;
+    if (columnCount != DETECTION_COLUMN_COUNT || rows > static_cast<size_t>(end - in)) return false;
+    for (uint32_t c = 0; c < columnCount; ++c) {
+        if (end - in < 4) return false;
+        uint32_t length = getU32(in);
+        in += 4;
+        if (length > static_cast<uint64_t>(end - in)) return false;
+        columns[c] = in;
+        columnEnds[c] = in + length;
+        in += length;
+    }
+    return in == end;
+}
+
+// Decodes every block in path in two steps. The dictionary columns are decoded
+// first and accept(const DetectionBlock&) decides whether the block is wanted;
+// only then are the timestamp and numeric columns decoded and
+// visit(const DetectionBlock&) called. Rejected blocks are skipped unparsed.
+// Damaged blocks are skipped too and their size added to damagedBytes.
+// Returns false only if the file cannot be read.
+template <typename Accept, typename Visitor>
+bool readDetectionBlocks(const std::string& path, Accept&& accept, Visitor&& visit, size_t& damagedBytes) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(data.data());
+    const unsigned char* end = in + data.size();
+    const unsigned char* magic = reinterpret_cast<const unsigned char*>(DETECTION_BLOCK_MAGIC);
+
+    DetectionBlock block;
+    const unsigned char* columns[DETECTION_COLUMN_COUNT];
+    const unsigned char* columnEnds[DETECTION_COLUMN_COUNT];
+    while (in < end) {
+        const unsigned char* payload = in + DETECTION_BLOCK_HEADER_BYTES;
+        bool framed = static_cast<size_t>(end - in) >= DETECTION_BLOCK_HEADER_BYTES &&
+                      std::memcmp(in, magic, sizeof(DETECTION_BLOCK_MAGIC)) == 0 &&
+                      getU32(in + 4) <= static_cast<size_t>(end - payload) &&
+                      detectionCrc32(payload, getU32(in + 4)) == getU32(in + 8);
+        if (!framed) {
+            const unsigned char* next = std::search(in + 1, end, magic, magic + sizeof(DETECTION_BLOCK_MAGIC));
+            damagedBytes += static_cast<size_t>(next - in);
+            in = next;
+            continue;
+        }
+        const unsigned char* payloadEnd = payload + getU32(in + 4);
+        size_t blockBytes = static_cast<size_t>(payloadEnd - in);
+        in = payloadEnd;
+
+        if (!splitDetectionColumns(payload, payloadEnd, block.rows, columns, columnEnds) ||
+            !decodeDictionaryColumn(columns[1], columnEnds[1], block.rows, block.userDictionary, block.userCode) ||
+            !decodeDictionaryColumn(columns[2], columnEnds[2], block.rows, block.typeDictionary, block.typeCode)) {
+            damagedBytes += blockBytes;
+            continue;
+        }
+        if (!accept(static_cast<const DetectionBlock&>(block))) continue;
+
+        bool ok = decodeIntColumn(columns[0], columnEnds[0], block.rows, block.timestamp) &&
+                  decodeDoubleColumn(columns[3], columnEnds[3], block.rows, block.severity) &&
+                  decodeDoubleColumn(columns[4], columnEnds[4], block.rows, block.speed) &&
+                  decodeDoubleColumn(columns[5], columnEnds[5], block.rows, block.movementEntropy) &&
+                  decodeDoubleColumn(columns[6], columnEnds[6], block.rows, block.aimSmoothness) &&
+                  decodeDoubleColumn(columns[7], columnEnds[7], block.rows, block.serverTickDelta) &&
+                  decodeDoubleColumn(columns[8], columnEnds[8], block.rows, block.hitMissRatio) &&
+                  decodeIntColumn(columns[9], columnEnds[9], block.rows, block.suspiciousEventCount);
+        if (!ok) {
+            damagedBytes += blockBytes;
+            continue;
+        }
+        visit(static_cast<const DetectionBlock&>(block));
+    }
+    return true;
+}
@@ -0,0 +1,250 @@
+// Offline scanner for detection exports written by the LunorAntiCheat exporter.
+//
+//   g++ -std=c++17 -O3 -march=native -I. analytics/LunorDetectionScan.cpp -o lunor_detection_scan
+//   ./lunor_detection_scan --type="Low Aim Smoothness" --from=1760000000 --group-by=hour exports/*.ldc
+//
+// Each block is filtered with branch-free passes over whole columns into a
+// selection mask, then aggregated per group. Type and user filters are resolved
+// against the block dictionary before the rest of the block is decoded, so
+// blocks without a match are skipped without decoding any numeric column.
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "LunorDetectionColumns.h"
+
+enum class GroupBy : unsigned char {
+    None,
+    Type,
+    User,
+    Hour
+};
+
+struct ScanOptions {
+    std::string type;
+    std::string user;
+    long long from = LLONG_MIN;
+    long long to = LLONG_MAX;
+    double minSeverity = -1.0;
+    GroupBy groupBy = GroupBy::Type;
+    std::vector<std::string> files;
+};
+
+const size_t SCAN_FEATURES = 7;
+const char* const SCAN_FEATURE_NAMES[SCAN_FEATURES] = {
+    "severity", "speed", "entropy", "smooth", "tickDelta", "hitMiss", "suspicious"
+};
+
+struct ScanGroup {
+    std::string label;
+    unsigned long long events = 0;
+    unsigned long long blocked = 0;
+    double sums[SCAN_FEATURES] = {};
+};
+
+struct ScanResult {
+    std::vector<ScanGroup> groups;
+    std::unordered_map<std::string, size_t> groupIndex;
+    unsigned long long rowsScanned = 0;
+    unsigned long long blocksSkipped = 0;
+
+    size_t group(const std::string& label) {
+        auto it = groupIndex.find(label);
+        if (it != groupIndex.end()) return it->second;
+        groupIndex.emplace(label, groups.size());
+        groups.push_back(ScanGroup{});
+        groups.back().label = label;
+        return groups.size() - 1;
+    }
+};
+
+long long findCode(const std::vector<std::string>& dictionary, const std::string& value) {
+    for (size_t i = 0; i < dictionary.size(); ++i) {
+        if (dictionary[i] == value) return static_cast<long long>(i);
+    }
+    return -1;
+}
+
+std::string hourLabel(long long timestamp) {
+    std::time_t seconds = static_cast<std::time_t>(timestamp);
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    char label[32];
+    std::strftime(label, sizeof(label), "%Y-%m-%d %H:00", &utc);
+    return label;
+}
+
+// Dictionary codes of the type and user filters in the current block, or -1 when unfiltered.
+struct BlockFilter {
+    long long typeCode = -1;
+    long long userCode = -1;
+};
+
+// Called with only the dictionary columns decoded; rejects blocks that cannot match.
+bool acceptBlock(const DetectionBlock& block, const ScanOptions& options, ScanResult& result, BlockFilter& filter) {
+    filter = BlockFilter{};
+    if ((!options.type.empty() && (filter.typeCode = findCode(block.typeDictionary, options.type)) < 0) ||
+        (!options.user.empty() && (filter.userCode = findCode(block.userDictionary, options.user)) < 0)) {
+        ++result.blocksSkipped;
+        return false;
+    }
+    return true;
+}
+
+void scanBlock(const DetectionBlock& block, const ScanOptions& options, const BlockFilter& filter, ScanResult& result,
+               std::vector<unsigned char>& keep, std::vector<uint32_t>& groupOf) {
+    const size_t rows = block.rows;
+    result.rowsScanned += rows;
+    const long long typeCode = filter.typeCode;
+    const long long userCode = filter.userCode;
+
+    keep.assign(rows, 1);
+    unsigned char* mask = keep.data();
+    const long long* timestamp = block.timestamp.data();
+    const double* severity = block.severity.data();
+    for (size_t i = 0; i < rows; ++i) {
+        mask[i] &= static_cast<unsigned char>((timestamp[i] >= options.from) & (timestamp[i] <= options.to));
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        mask[i] &= static_cast<unsigned char>(severity[i] >= options.minSeverity);
+    }
+    if (typeCode >= 0) {
+        const uint32_t* codes = block.typeCode.data();
+        uint32_t wanted = static_cast<uint32_t>(typeCode);
+        for (size_t i = 0; i < rows; ++i) mask[i] &= static_cast<unsigned char>(codes[i] == wanted);
+    }
+    if (userCode >= 0) {
+        const uint32_t* codes = block.userCode.data();
+        uint32_t wanted = static_cast<uint32_t>(userCode);
+        for (size_t i = 0; i < rows; ++i) mask[i] &= static_cast<unsigned char>(codes[i] == wanted);
+    }
+
+    // Resolve each row's group once; dictionary groupings only map the block dictionary.
+    groupOf.resize(rows);
+    if (options.groupBy == GroupBy::Type || options.groupBy == GroupBy::User) {
+        const auto& dictionary = options.groupBy == GroupBy::Type ? block.typeDictionary : block.userDictionary;
+        const auto& codes = options.groupBy == GroupBy::Type ? block.typeCode : block.userCode;
+        std::vector<uint32_t> remap(dictionary.size());
+        for (size_t code = 0; code < dictionary.size(); ++code) {
+            remap[code] = static_cast<uint32_t>(result.group(dictionary[code]));
+        }
+        for (size_t i = 0; i < rows; ++i) groupOf[i] = remap[codes[i]];
+    } else if (options.groupBy == GroupBy::Hour) {
+        long long lastHour = LLONG_MIN;
+        uint32_t lastGroup = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            if (!mask[i]) continue;
+            long long hour = timestamp[i] / 3600;
+            if (hour != lastHour) {
+                lastHour = hour;
+                lastGroup = static_cast<uint32_t>(result.group(hourLabel(hour * 3600)));
+            }
+            groupOf[i] = lastGroup;
+        }
+    } else {
+        uint32_t all = static_cast<uint32_t>(result.group("all"));
+        std::fill(groupOf.begin(), groupOf.end(), all);
+    }
+
+    const double* features[SCAN_FEATURES - 1] = {
+        block.severity.data(), block.speed.data(), block.movementEntropy.data(), block.aimSmoothness.data(),
+        block.serverTickDelta.data(), block.hitMissRatio.data()
+    };
+    const long long* suspicious = block.suspiciousEventCount.data();
+    for (size_t i = 0; i < rows; ++i) {
+        if (!mask[i]) continue;
+        ScanGroup& group = result.groups[groupOf[i]];
+        ++group.events;
+        group.blocked += severity[i] >= 1.0;
+        for (size_t f = 0; f < SCAN_FEATURES - 1; ++f) group.sums[f] += features[f][i];
+        group.sums[SCAN_FEATURES - 1] += static_cast<double>(suspicious[i]);
+    }
+}
+
+bool parseFlag(const char* arg, const char* name, std::string& value) {
+    size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=') return false;
+    value = arg + length + 1;
+    return true;
+}
+
+ScanOptions parseArgs(int argc, char** argv) {
+    ScanOptions options;
+    bool valid = true;
+    for (int i = 1; i < argc && valid; ++i) {
+        std::string value;
+        if (parseFlag(argv[i], "--type", value)) options.type = value;
+        else if (parseFlag(argv[i], "--user", value)) options.user = value;
+        else if (parseFlag(argv[i], "--from", value)) options.from = std::atoll(value.c_str());
+        else if (parseFlag(argv[i], "--to", value)) options.to = std::atoll(value.c_str());
+        else if (parseFlag(argv[i], "--min-severity", value)) options.minSeverity = std::atof(value.c_str());
+        else if (parseFlag(argv[i], "--group-by", value)) {
+            if (value == "none") options.groupBy = GroupBy::None;
+            else if (value == "type") options.groupBy = GroupBy::Type;
+            else if (value == "user") options.groupBy = GroupBy::User;
+            else if (value == "hour") options.groupBy = GroupBy::Hour;
+            else valid = false;
+        } else if (argv[i][0] != '-') options.files.push_back(argv[i]);
+        else valid = false;
+    }
+    if (!valid || options.files.empty()) {
+        std::fprintf(stderr,
+            "usage: %s [--type=NAME] [--user=ID] [--from=EPOCH] [--to=EPOCH] [--min-severity=X]\n"
+            "          [--group-by=none|type|user|hour] FILE...\n",
+            argv[0]);
+        std::exit(2);
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    ScanOptions options = parseArgs(argc, argv);
+    ScanResult result;
+    std::vector<unsigned char> keep;
+    std::vector<uint32_t> groupOf;
+    BlockFilter filter;
+
+    int failures = 0;
+    for (const auto& path : options.files) {
+        size_t damagedBytes = 0;
+        bool ok = readDetectionBlocks(path,
+            [&](const DetectionBlock& block) { return acceptBlock(block, options, result, filter); },
+            [&](const DetectionBlock& block) { scanBlock(block, options, filter, result, keep, groupOf); },
+            damagedBytes);
+        if (!ok) {
+            std::fprintf(stderr, "%s: unreadable detection export\n", path.c_str());
+            ++failures;
+        } else if (damagedBytes > 0) {
+            std::fprintf(stderr, "%s: skipped %zu damaged bytes\n", path.c_str(), damagedBytes);
+        }
+    }
+
+    std::vector<const ScanGroup*> rows;
+    for (const auto& group : result.groups) {
+        if (group.events > 0) rows.push_back(&group);
+    }
+    std::sort(rows.begin(), rows.end(), [&](const ScanGroup* a, const ScanGroup* b) {
+        if (options.groupBy == GroupBy::Hour) return a->label < b->label;
+        return a->events > b->events;
+    });
+
+    std::printf("%-36s %10s %8s", "group", "events", "blocked%");
+    for (const char* name : SCAN_FEATURE_NAMES) std::printf(" %10s", name);
+    std::printf("\n");
+    for (const ScanGroup* group : rows) {
+        double events = static_cast<double>(group->events);
+        std::printf("%-36.36s %10llu %7.2f%%", group->label.c_str(), group->events, 100.0 * group->blocked / events);
+        for (double sum : group->sums) std::printf(" %10.3f", sum / events);
+        std::printf("\n");
+    }
+    std::fprintf(stderr, "scanned %llu rows, skipped %llu blocks by dictionary\n",
+        result.rowsScanned, result.blocksSkipped);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,533 @@
+// Soak/load harness for LunorAntiCheat.
+//
+// Simulates a large population of concurrent players against an in-process
+// stand-in for the socket.js WebSocket server and drives every action through
+// validatePlayerAction and the Report/User/HWIDBan sinks. The sinks are the
+// in-memory fakes in soak/fakes, picked up ahead of the production headers:
+//
+//   g++ -std=c++17 -O2 -pthread -Isoak/fakes soak/LunorSoak.cpp -o lunor_soak
+//   ./lunor_soak --players=20000 --rate=20 --duration=3600 --cheaters=0.02
+//
+// Every --interval seconds it prints throughput, p50/p99/p999 latency and
+// resident memory growth since warmup; a summary is printed at the end.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+// The anti-cheat is a single translation unit with no public header, so the
+// harness compiles it in directly.
+#include "../LunorAntiCheat.cpp"
+
+using SoakClock = std::chrono::steady_clock;
+
+struct SoakConfig {
+    int players = 20000;
+    double rate = 20.0;
+    int duration = 60;
+    int warmup = 5;
+    int interval = 10;
+    int workers = 0;
+    int generators = 2;
+    double cheaters = 0.02;
+    double suspicious = 0.05;
+    size_t maxQueue = 1 << 20;
+    std::string exportDir;
+};
+
+enum class Behavior : unsigned char {
+    Clean,
+    Suspicious,
+    SpeedHack,
+    Teleport,
+    BlockedSource,
+    Aimbot,
+    RapidFire,
+    Count
+};
+
+const Behavior CHEAT_BEHAVIORS[] = {
+    Behavior::SpeedHack,
+    Behavior::Teleport,
+    Behavior::BlockedSource,
+    Behavior::Aimbot,
+    Behavior::RapidFire
+};
+
+const char* const CHEAT_SOURCES[] = {
+    "aimbot_loader.dll",
+    "Lunor_Client_ESP_Hack",
+    "cheatengine-7.5",
+    "modmenu_v3"
+};
+
+// Log-linear latency histogram in nanoseconds (16 sub-buckets per power of two).
+// Counters are relaxed atomics so the reporter can read while workers record.
+struct LatencyHistogram {
+    static const int BUCKETS = 64 * 16;
+    std::atomic<unsigned long long> counts[BUCKETS];
+
+    LatencyHistogram() {
+        for (auto& count : counts) count.store(0, std::memory_order_relaxed);
+    }
+
+    static int bucketFor(unsigned long long ns) {
+        if (ns < 16) return static_cast<int>(ns);
+        int msb = 63 - __builtin_clzll(ns);
+        int sub = static_cast<int>((ns >> (msb - 4)) & 15);
+        return (msb - 3) * 16 + sub;
+    }
+
+    static unsigned long long bucketUpperBound(int bucket) {
+        if (bucket < 16) return static_cast<unsigned long long>(bucket);
+        int msb = bucket / 16 + 3;
+        unsigned long long sub = static_cast<unsigned long long>(bucket % 16);
+        return ((16 + sub + 1) << (msb - 4)) - 1;
+    }
+
+    void record(unsigned long long ns) {
+        counts[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void snapshot(std::vector<unsigned long long>& out) const {
+        out.resize(BUCKETS);
+        for (int i = 0; i < BUCKETS; ++i) out[i] = counts[i].load(std::memory_order_relaxed);
+    }
+};
+
+unsigned long long percentile(const std::vector<unsigned long long>& counts, double p) {
+    unsigned long long total = 0;
+    for (auto count : counts) total += count;
+    if (total == 0) return 0;
+    unsigned long long target = static_cast<unsigned long long>(p * static_cast<double>(total - 1)) + 1;
+    unsigned long long seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= target) return LatencyHistogram::bucketUpperBound(static_cast<int>(i));
+    }
+    return 0;
+}
+
+struct Rng {
+    unsigned long long state;
+
+    explicit Rng(unsigned long long seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+
+    unsigned long long next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    double uniform() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    double range(double lo, double hi) {
+        return lo + (hi - lo) * uniform();
+    }
+};
+
+// One inbound message on the stand-in socket. The payload itself is synthesized
+// by the owning worker from the connection's behavior, like socket.js handing a
+// parsed message to the backend.
+struct Frame {
+    unsigned int connectionId;
+    SoakClock::time_point enqueuedAt;
+};
+
+// Server-side view of one client connection, owned by exactly one worker.
+struct Connection {
+    Behavior behavior = Behavior::Clean;
+    unsigned long long generation = 0;
+    long long actions = 0;
+    long long cheatOnset = 0;
+    PlayerState current{};
+    PlayerState previous{};
+    Payload payload{};
+};
+
+struct WorkerQueue {
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::vector<Frame> frames;
+};
+
+struct SoakStats {
+    std::atomic<unsigned long long> completed{0};
+    std::atomic<unsigned long long> rejected{0};
+    std::atomic<unsigned long long> reconnects{0};
+    std::atomic<unsigned long long> dropped{0};
+    std::atomic<unsigned long long> rejectedByCode[static_cast<size_t>(ValidationCode::Count)] = {};
+    LatencyHistogram validateLatency;
+    LatencyHistogram endToEndLatency;
+};
+
+// In-process replacement for the socket.js server: connections are pinned to a
+// worker so each player's actions are validated in order, and generators play
+// the role of clients sending frames at a fixed per-player rate.
+class SocketStandIn {
+public:
+    SocketStandIn(const SoakConfig& config, SoakStats& stats)
+        : config(config), stats(stats), queues(config.workers), connections(config.players) {}
+
+    void start() {
+        for (int w = 0; w < config.workers; ++w) {
+            workerThreads.emplace_back([this, w] { runWorker(w); });
+        }
+        for (int g = 0; g < config.generators; ++g) {
+            generatorThreads.emplace_back([this, g] { runGenerator(g); });
+        }
+    }
+
+    void stop() {
+        running.store(false);
+        for (auto& thread : generatorThreads) thread.join();
+        for (auto& queue : queues) {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.ready.notify_all();
+        }
+        for (auto& thread : workerThreads) thread.join();
+    }
+
+private:
+    const SoakConfig& config;
+    SoakStats& stats;
+    std::vector<WorkerQueue> queues;
+    std::vector<Connection> connections;
+    std::vector<std::thread> workerThreads;
+    std::vector<std::thread> generatorThreads;
+    std::atomic<bool> running{true};
+
+    void runGenerator(int index) {
+        const int slots = 10;
+        auto period = std::chrono::duration_cast<SoakClock::duration>(std::chrono::duration<double>(1.0 / config.rate));
+        auto slotPeriod = period / slots;
+        auto next = SoakClock::now() + slotPeriod * index / config.generators;
+        std::vector<std::vector<Frame>> batches(config.workers);
+        long long slot = 0;
+
+        while (running.load(std::memory_order_relaxed)) {
+            std::this_thread::sleep_until(next);
+            next += slotPeriod;
+            auto now = SoakClock::now();
+
+            for (unsigned int id = static_cast<unsigned int>(index); id < connections.size();
+                 id += static_cast<unsigned int>(config.generators)) {
+                if ((id / config.generators) % slots != static_cast<unsigned int>(slot % slots)) continue;
+                batches[id % config.workers].push_back({id, now});
+            }
+            ++slot;
+
+            for (int w = 0; w < config.workers; ++w) {
+                if (batches[w].empty()) continue;
+                WorkerQueue& queue = queues[w];
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (queue.frames.size() + batches[w].size() > config.maxQueue) {
+                        stats.dropped.fetch_add(batches[w].size(), std::memory_order_relaxed);
+                    } else {
+                        queue.frames.insert(queue.frames.end(), batches[w].begin(), batches[w].end());
+                    }
+                }
+                queue.ready.notify_one();
+                batches[w].clear();
+            }
+        }
+    }
+
+    void runWorker(int index) {
+        Rng rng(static_cast<unsigned long long>(index) + 1);
+        WorkerQueue& queue = queues[index];
+        std::vector<Frame> local;
+
+        for (size_t id = static_cast<size_t>(index); id < connections.size(); id += static_cast<size_t>(config.workers)) {
+            connect(connections[id], id, rng);
+        }
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.ready.wait(lock, [&] { return !queue.frames.empty() || !running.load(); });
+                if (queue.frames.empty() && !running.load()) return;
+                local.swap(queue.frames);
+            }
+            for (const Frame& frame : local) {
+                handleFrame(frame, rng);
+            }
+            local.clear();
+        }
+    }
+
+    void connect(Connection& conn, size_t id, Rng& rng) {
+        if (conn.generation > 0) forgetTrajectory(conn.current.userId);
+        ++conn.generation;
+        conn.actions = 0;
+        conn.cheatOnset = static_cast<long long>(rng.range(0, 200));
+
+        double roll = rng.uniform();
+        if (roll < config.cheaters) {
+            size_t pick = static_cast<size_t>(rng.next() % (sizeof(CHEAT_BEHAVIORS) / sizeof(CHEAT_BEHAVIORS[0])));
+            conn.behavior = CHEAT_BEHAVIORS[pick];
+        } else if (roll < config.cheaters + config.suspicious) {
+            conn.behavior = Behavior::Suspicious;
+        } else {
+            conn.behavior = Behavior::Clean;
+        }
+
+        std::string tag = std::to_string(id) + "-" + std::to_string(conn.generation);
+        PlayerState& state = conn.current;
+        state = PlayerState{};
+        state.userId = "soak-user-" + tag;
+        state.hwid = "soak-hwid-" + tag;
+        state.src = "Lunor_Client_Win64_Shipping";
+        state.ipAddress = "192.168." + std::to_string((id >> 8) & 255) + "." + std::to_string(id & 255);
+        state.sessionId = "soak-session-" + tag;
+        state.position.x = rng.range(-1000, 1000);
+        state.position.y = rng.range(-1000, 1000);
+        state.movementEntropy = 0.8;
+        state.aimSmoothness = 0.6;
+        state.hitMissRatio = 0.4;
+        conn.previous = state;
+        conn.payload = Payload{};
+        conn.payload.fire.fireTimestamps.reserve(8);
+    }
+
+    void synthesize(Connection& conn, Rng& rng, long long nowMs) {
+        PlayerState& state = conn.current;
+        Payload& payload = conn.payload;
+        bool cheating = conn.behavior != Behavior::Clean && conn.behavior != Behavior::Suspicious &&
+                        conn.actions >= conn.cheatOnset;
+
+        state.speed = rng.range(0, 90);
+        state.position.x += rng.range(-5, 5);
+        state.position.y += rng.range(-5, 5);
+        state.movementEntropy = rng.range(0.4, 1.0);
+        state.aimSmoothness = rng.range(0.3, 0.9);
+        state.serverTickDelta = rng.range(0.0, 0.2);
+        state.suspiciousEventCount = 0;
+        state.lastActionTimestamp = nowMs;
+
+        payload.aim.angle = conn.previous.position.x + rng.range(-10, 10);
+        payload.aim.timestamp = nowMs;
+        payload.aim.hitRate = rng.range(0.1, 0.6);
+        payload.aim.shots = static_cast<int>(rng.range(0, 30));
+        payload.fire.fireTimestamps.clear();
+        if (conn.actions % 4 == 0) {
+            payload.fire.fireTimestamps.push_back(nowMs - 300);
+            payload.fire.fireTimestamps.push_back(nowMs - 150);
+            payload.fire.fireTimestamps.push_back(nowMs);
+        }
+
+        if (conn.behavior == Behavior::Suspicious && conn.actions % 50 == 0) {
+            state.movementEntropy = 0.1;
+            state.serverTickDelta = 0.7;
+        }
+        if (!cheating) return;
+
+        switch (conn.behavior) {
+            case Behavior::SpeedHack:
+                state.speed = rng.range(150, 400);
+                break;
+            case Behavior::Teleport:
+                state.position.x += rng.range(80, 500);
+                break;
+            case Behavior::BlockedSource:
+                state.src = CHEAT_SOURCES[rng.next() % (sizeof(CHEAT_SOURCES) / sizeof(CHEAT_SOURCES[0]))];
+                break;
+            case Behavior::Aimbot:
+                payload.aim.hitRate = 1.0;
+                payload.aim.shots = 40;
+                break;
+            case Behavior::RapidFire:
+                payload.fire.fireTimestamps.push_back(nowMs + 20);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void handleFrame(const Frame& frame, Rng& rng) {
+        Connection& conn = connections[frame.connectionId];
+        long long nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        synthesize(conn, rng, nowMs);
+
+        static const std::string MOVE_ACTION = "move";
+        static const std::string FIRE_ACTION = "fire";
+        const std::string& actionType = conn.payload.fire.fireTimestamps.empty() ? MOVE_ACTION : FIRE_ACTION;
+
+        auto validateStart = SoakClock::now();
+        ValidationResult result = validatePlayerAction(conn.current, conn.previous, actionType, conn.payload);
+        auto done = SoakClock::now();
+
+        stats.validateLatency.record(static_cast<unsigned long long>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(done - validateStart).count()));
+        stats.endToEndLatency.record(static_cast<unsigned long long>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(done - frame.enqueuedAt).count()));
+        stats.completed.fetch_add(1, std::memory_order_relaxed);
+        ++conn.actions;
+
+        if (result.code == ValidationCode::Throttled) {
+            stats.rejected.fetch_add(1, std::memory_order_relaxed);
+            stats.rejectedByCode[static_cast<size_t>(result.code)].fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (!result.valid) {
+            // The real server drops a banned client; model it as a fresh player taking the slot.
+            stats.rejected.fetch_add(1, std::memory_order_relaxed);
+            stats.rejectedByCode[static_cast<size_t>(result.code)].fetch_add(1, std::memory_order_relaxed);
+            stats.reconnects.fetch_add(1, std::memory_order_relaxed);
+            connect(conn, frame.connectionId, rng);
+            return;
+        }
+        conn.previous = conn.current;
+    }
+};
+
+long long residentBytes() {
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) return 0;
+    long long pages = 0;
+    long long resident = 0;
+    if (std::fscanf(statm, "%lld %lld", &pages, &resident) != 2) resident = 0;
+    std::fclose(statm);
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+size_t cheatLogCount() {
+    std::lock_guard<std::mutex> lock(cheatLogsMutex);
+    return cheatLogs.size();
+}
+
+bool parseFlag(const char* arg, const char* name, std::string& value) {
+    size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=') return false;
+    value = arg + length + 1;
+    return true;
+}
+
+SoakConfig parseArgs(int argc, char** argv) {
+    SoakConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string value;
+        if (parseFlag(argv[i], "--players", value)) config.players = std::atoi(value.c_str());
+        else if (parseFlag(argv[i], "--rate", value)) config.rate = std::atof(value.c_str());
+        else if (parseFlag(argv[i], "--duration", value)) config.duration = std::atoi(value.c_str());
+        else if (parseFlag(argv[i], "--warmup", value)) config.warmup = std::atoi(value.c_str());
+        else if (parseFlag(argv[i], "--interval", value)) config.interval = std::atoi(value.c_str());
+        else if (parseFlag(argv[i], "--workers", value)) config.workers = std::atoi(value.c_str());
+        else if (parseFlag(argv[i], "--generators", value)) config.generators = std::atoi(value.c_str());
+        else if (parseFlag(argv[i], "--cheaters", value)) config.cheaters = std::atof(value.c_str());
+        else if (parseFlag(argv[i], "--suspicious", value)) config.suspicious = std::atof(value.c_str());
+        else if (parseFlag(argv[i], "--max-queue", value)) config.maxQueue = std::strtoull(value.c_str(), nullptr, 10);
+        else if (parseFlag(argv[i], "--export-dir", value)) config.exportDir = value;
+        else {
+            std::fprintf(stderr,
+                "usage: %s [--players=N] [--rate=HZ] [--duration=S] [--warmup=S] [--interval=S]\n"
+                "          [--workers=N] [--generators=N] [--cheaters=F] [--suspicious=F] [--max-queue=N]\n"
+                "          [--export-dir=DIR]\n",
+                argv[0]);
+            std::exit(2);
+        }
+    }
+    if (config.workers <= 0) {
+        config.workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - config.generators);
+    }
+    config.players = std::max(1, config.players);
+    config.generators = std::max(1, config.generators);
+    config.interval = std::max(1, config.interval);
+    config.rate = std::max(0.1, config.rate);
+    return config;
+}
+
+void printLatency(const char* label, const LatencyHistogram& histogram) {
+    std::vector<unsigned long long> counts;
+    histogram.snapshot(counts);
+    std::printf("%s p50=%.1fus p99=%.1fus p999=%.1fus", label,
+        percentile(counts, 0.50) / 1000.0, percentile(counts, 0.99) / 1000.0, percentile(counts, 0.999) / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    SoakConfig config = parseArgs(argc, argv);
+    std::printf("soak: players=%d rate=%.1fHz duration=%ds workers=%d generators=%d cheaters=%.3f suspicious=%.3f\n",
+        config.players, config.rate, config.duration, config.workers, config.generators,
+        config.cheaters, config.suspicious);
+
+    if (!config.exportDir.empty()) startDetectionExporter(config.exportDir);
+    reserveTrajectoryCapacity(static_cast<size_t>(config.players), static_cast<size_t>(config.players));
+    SoakStats stats;
+    SocketStandIn server(config, stats);
+    long long startRss = residentBytes();
+    server.start();
+
+    auto start = SoakClock::now();
+    auto end = start + std::chrono::seconds(config.duration);
+    auto warmupEnd = start + std::chrono::seconds(std::min(config.warmup, config.duration));
+    std::this_thread::sleep_until(warmupEnd);
+    long long baselineRss = residentBytes();
+    unsigned long long lastCompleted = stats.completed.load();
+    auto lastReport = SoakClock::now();
+
+    while (SoakClock::now() < end) {
+        std::this_thread::sleep_until(std::min(end, lastReport + std::chrono::seconds(config.interval)));
+        auto now = SoakClock::now();
+        unsigned long long completed = stats.completed.load();
+        double seconds = std::chrono::duration<double>(now - lastReport).count();
+        long long rss = residentBytes();
+
+        std::printf("[%6.0fs] %10.0f actions/s  ", std::chrono::duration<double>(now - start).count(),
+            (completed - lastCompleted) / seconds);
+        printLatency("validate", stats.validateLatency);
+        std::printf("  ");
+        printLatency("e2e", stats.endToEndLatency);
+        std::printf("  rss=%.1fMiB (+%.1fMiB) trajectories=%.1fMiB cheatLogs=%zu hwidBans=%zu dropped=%llu\n",
+            rss / 1048576.0, (rss - baselineRss) / 1048576.0, trajectoryChunkPool.reservedBytes() / 1048576.0,
+            cheatLogCount(), fakeHWIDBanCount(), stats.dropped.load());
+        std::fflush(stdout);
+
+        lastCompleted = completed;
+        lastReport = now;
+    }
+
+    server.stop();
+    stopDetectionExporter();
+    double elapsed = std::chrono::duration<double>(SoakClock::now() - start).count();
+    long long endRss = residentBytes();
+
+    std::printf("\nsummary: %llu actions in %.0fs (%.0f actions/s), %llu rejected, %llu dropped\n",
+        stats.completed.load(), elapsed, stats.completed.load() / elapsed, stats.rejected.load(), stats.dropped.load());
+    printLatency("  validate", stats.validateLatency);
+    std::printf("\n");
+    printLatency("  e2e     ", stats.endToEndLatency);
+    std::printf("\n  rss start=%.1fMiB warm=%.1fMiB end=%.1fMiB growth=%.1fMiB (%.2fMiB/min after warmup)\n",
+        startRss / 1048576.0, baselineRss / 1048576.0, endRss / 1048576.0, (endRss - baselineRss) / 1048576.0,
+        (endRss - baselineRss) / 1048576.0 / std::max(1.0, (elapsed - config.warmup) / 60.0));
+    std::printf("  sinks: reports=%llu userBans=%llu hwidLookups=%llu hwidBans=%zu (evicted %llu) cheatLogs=%zu\n",
+        fakeReportSaves.load(), fakeUserBans.load(), fakeHWIDBanLookups.load(), fakeHWIDBanCount(),
+        fakeHWIDBanEvictions.load(), cheatLogCount());
+    std::printf("  admission: admitted=%llu sampled=%llu throttled=%llu floodEpisodes=%llu evictions=%llu\n",
+        admissionStats.admitted.load(), admissionStats.sampled.load(), admissionStats.throttled.load(),
+        admissionStats.floodEpisodes.load(), admissionStats.evictions.load());
+    if (!config.exportDir.empty()) {
+        std::printf("  export: exported=%llu dropped=%llu writeFailures=%llu\n", detectionExporter.exported.load(),
+            detectionExporter.dropped.load(), detectionExporter.writeFailures.load());
+    }
+    for (size_t code = 1; code < static_cast<size_t>(ValidationCode::Count); ++code) {
+        unsigned long long count = stats.rejectedByCode[code].load();
+        if (count == 0) continue;
+        std::printf("  rejected %-40.*s %llu\n", static_cast<int>(VALIDATION_REASON_TEXT[code].size()),
+            VALIDATION_REASON_TEXT[code].data(), count);
+    }
+    return 0;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+// In-memory stand-in for the production HWIDBan model, used by the soak harness.
+// Bans are kept so isBanned behaves like the real lookup on every validated action.
+// Banned soak players reconnect with a fresh HWID and never reuse the old one,
+// so the table is capped at FAKE_HWID_BAN_LIMIT by evicting the oldest ban.
+// The harness reports the table size next to cheatLogs.
+
+#include <atomic>
+#include <cstddef>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+const size_t FAKE_HWID_BAN_LIMIT = 4096;
+
+inline std::shared_mutex fakeHWIDBansMutex;
+inline std::unordered_map<std::string, std::time_t> fakeHWIDBans;
+inline std::deque<std::string> fakeHWIDBanOrder;
+inline std::atomic<unsigned long long> fakeHWIDBanLookups{0};
+inline std::atomic<unsigned long long> fakeHWIDBanEvictions{0};
+
+class HWIDBan {
+public:
+    static void ban(const std::string& hwid, const std::string& reason, const std::string& userId,
+                    std::time_t bannedAt, std::time_t expiresAt) {
+        (void)reason;
+        (void)userId;
+        (void)bannedAt;
+        std::unique_lock<std::shared_mutex> lock(fakeHWIDBansMutex);
+        if (!fakeHWIDBans.insert_or_assign(hwid, expiresAt).second) return;
+        fakeHWIDBanOrder.push_back(hwid);
+        while (fakeHWIDBans.size() > FAKE_HWID_BAN_LIMIT) {
+            fakeHWIDBans.erase(fakeHWIDBanOrder.front());
+            fakeHWIDBanOrder.pop_front();
+            fakeHWIDBanEvictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    static bool isBanned(const std::string& hwid, std::time_t now) {
+        fakeHWIDBanLookups.fetch_add(1, std::memory_order_relaxed);
+        std::shared_lock<std::shared_mutex> lock(fakeHWIDBansMutex);
+        auto it = fakeHWIDBans.find(hwid);
+        return it != fakeHWIDBans.end() && it->second > now;
+    }
+};
+
+inline size_t fakeHWIDBanCount() {
+    std::shared_lock<std::shared_mutex> lock(fakeHWIDBansMutex);
+    return fakeHWIDBans.size();
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// In-memory stand-in for the production Report model, used by the soak harness.
+// Only counts saves so the fake itself does not contribute to memory growth.
+
+#include <atomic>
+#include <ctime>
+#include <string>
+
+inline std::atomic<unsigned long long> fakeReportSaves{0};
+
+class Report {
+public:
+    Report(const std::string& userId, const std::string& reason, const std::string& details, std::time_t timestamp)
+        : userId(userId), reason(reason), details(details), timestamp(timestamp) {}
+
+    void save() {
+        fakeReportSaves.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    std::string userId;
+    std::string reason;
+    std::string details;
+    std::time_t timestamp;
+};
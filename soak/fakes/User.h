@@ -0,0 +1,19 @@
+#pragma once
+
+// In-memory stand-in for the production User model, used by the soak harness.
+
+#include <atomic>
+#include <ctime>
+#include <string>
+
+inline std::atomic<unsigned long long> fakeUserBans{0};
+
+class User {
+public:
+    static void ban(const std::string& userId, const std::string& reason, std::time_t timestamp) {
+        (void)userId;
+        (void)reason;
+        (void)timestamp;
+        fakeUserBans.fetch_add(1, std::memory_order_relaxed);
+    }
+};
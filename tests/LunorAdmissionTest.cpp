@@ -0,0 +1,115 @@
+// Drives the admission token buckets with explicit ticks: burst and refill rate,
+// flood episodes and sampling, and clock reads that race the shard lock.
+//
+//   g++ -std=c++17 -O2 -pthread -Isoak/fakes tests/LunorAdmissionTest.cpp -o lunor_admission_test && ./lunor_admission_test
+//
+// Every case uses its own id, so buckets never interact. Ticks are
+// ADMISSION_TICK_MS apart.
+
+#include <cstdio>
+#include <string>
+
+#include "../LunorAntiCheat.cpp"
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (condition) return;
+    std::fprintf(stderr, "FAIL: %s\n", what);
+    ++failures;
+}
+
+struct Tally {
+    unsigned admitted = 0;
+    unsigned sampled = 0;
+    unsigned throttled = 0;
+    unsigned floodStarts = 0;
+
+    void add(AdmissionDecision decision) {
+        switch (decision) {
+            case AdmissionDecision::Admitted: ++admitted; break;
+            case AdmissionDecision::Sampled: ++sampled; break;
+            case AdmissionDecision::Throttled: ++throttled; break;
+            case AdmissionDecision::FloodStarted: ++floodStarts; break;
+        }
+    }
+};
+
+AdmissionDecision takePlayer(const std::string& id, uint32_t tick) {
+    return takeToken(id, ADMISSION_PLAYER_SEED, ADMISSION_PLAYER_RATE, ADMISSION_PLAYER_BURST, tick);
+}
+
+AdmissionDecision takeHwid(const std::string& id, uint32_t tick) {
+    return takeToken(id, ADMISSION_HWID_SEED, ADMISSION_HWID_RATE, ADMISSION_HWID_BURST, tick);
+}
+
+void testBurstAndRefill() {
+    Tally burst;
+    for (unsigned i = 0; i < ADMISSION_PLAYER_BURST + 10; ++i) burst.add(takePlayer("burst", 1000));
+    check(burst.admitted == ADMISSION_PLAYER_BURST, "burst: exactly the burst is admitted in one tick");
+    check(burst.floodStarts == 1, "burst: first excess action starts a flood episode");
+
+    // One second later roughly ADMISSION_PLAYER_RATE tokens have come back.
+    uint32_t later = 1000 + 1000 / ADMISSION_TICK_MS;
+    Tally refill;
+    for (unsigned i = 0; i < ADMISSION_PLAYER_BURST; ++i) refill.add(takePlayer("burst", later));
+    check(refill.admitted >= ADMISSION_PLAYER_RATE - 2 && refill.admitted <= ADMISSION_PLAYER_RATE + 1,
+        "refill: about one second of tokens comes back");
+    check(refill.floodStarts == 0, "refill: still inside the same flood episode");
+}
+
+void testFloodEpisodes() {
+    // 1000 actions/s for 3 s: one episode, the rate admitted, and sampled excess.
+    Tally flood;
+    uint32_t tick = 5000;
+    const unsigned perTick = 16;
+    for (unsigned t = 0; t < 3000 / ADMISSION_TICK_MS; ++t, ++tick) {
+        for (unsigned i = 0; i < perTick; ++i) flood.add(takePlayer("flood", tick));
+    }
+    unsigned total = flood.admitted + flood.sampled + flood.throttled + flood.floodStarts;
+    check(flood.floodStarts == 1, "flood: one episode for a sustained flood");
+    check(flood.admitted <= ADMISSION_PLAYER_BURST + 3 * ADMISSION_PLAYER_RATE + 1, "flood: admitted at the rate limit");
+    check(flood.sampled > 0 && flood.sampled <= total / ADMISSION_SAMPLE_EVERY + 1, "flood: one in SAMPLE_EVERY sampled");
+
+    // After a full refill the next drain is a new episode.
+    tick += ADMISSION_PLAYER_BURST * 1000 / ADMISSION_PLAYER_RATE / ADMISSION_TICK_MS + 2;
+    Tally second;
+    for (unsigned i = 0; i < ADMISSION_PLAYER_BURST + 1; ++i) second.add(takePlayer("flood", tick));
+    check(second.admitted == ADMISSION_PLAYER_BURST, "flood: bucket refilled completely after going quiet");
+    check(second.floodStarts == 1, "flood: a new episode starts after a full refill");
+}
+
+void testStaleTick() {
+    // Another thread stored lastTick = 101 before this one, which read 100.
+    Tally drain;
+    for (unsigned i = 0; i < ADMISSION_HWID_BURST; ++i) drain.add(takeHwid("stale-hwid", 101));
+    check(drain.admitted == ADMISSION_HWID_BURST, "stale: bucket drained at tick 101");
+
+    Tally late;
+    for (unsigned i = 0; i < ADMISSION_HWID_BURST; ++i) late.add(takeHwid("stale-hwid", 100));
+    check(late.admitted == 0, "stale: a trailing tick refills nothing");
+    check(late.floodStarts == 1, "stale: the trailing caller is throttled");
+}
+
+void testTickWraparound() {
+    uint32_t beforeWrap = UINT32_MAX - 2;
+    for (unsigned i = 0; i < ADMISSION_PLAYER_BURST; ++i) takePlayer("wrap", beforeWrap);
+    Tally after;
+    for (unsigned i = 0; i < ADMISSION_PLAYER_BURST; ++i) after.add(takePlayer("wrap", beforeWrap + 1000 / ADMISSION_TICK_MS));
+    check(after.admitted >= ADMISSION_PLAYER_RATE - 2 && after.admitted <= ADMISSION_PLAYER_RATE + 1,
+        "wrap: refill is measured across the 32-bit tick wrap");
+}
+
+int main() {
+    testBurstAndRefill();
+    testFloodEpisodes();
+    testStaleTick();
+    testTickWraparound();
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d admission checks failed\n", failures);
+        return 1;
+    }
+    std::printf("PASS: admission buckets\n");
+    return 0;
+}
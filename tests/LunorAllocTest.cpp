@@ -0,0 +1,146 @@
+// Enforces that validating a clean player's action makes no heap allocations.
+//
+//   g++ -std=c++17 -O2 -pthread -Isoak/fakes tests/LunorAllocTest.cpp -o lunor_alloc_test && ./lunor_alloc_test
+//
+// Every operator new is counted. The trajectory store is pre-sized with
+// reserveTrajectoryCapacity, as a host does at startup. The one allowed
+// exception is a player's first action, which inserts their trajectory map node
+// and may allocate up to FIRST_ACTION_ALLOCATIONS times; every later action must
+// allocate nothing. The measured actions stay inside the 120-action admission
+// burst, so they exercise the full detector chain and not the Throttled path.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "../LunorAntiCheat.cpp"
+
+std::atomic<unsigned long long> allocationCount{0};
+
+// Every replaceable allocation form is overridden, so no new/delete pair mixes
+// the counting allocator with the library's.
+void* countedAllocate(std::size_t size, std::size_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    void* memory = nullptr;
+    if (alignment <= alignof(std::max_align_t)) memory = std::malloc(size);
+    else if (posix_memalign(&memory, alignment, size) != 0) memory = nullptr;
+    return memory;
+}
+
+// Kept out of line so the compiler never sees a std::free paired with an
+// operator new result, which -Wmismatched-new-delete would flag.
+[[gnu::noinline]] void countedRelease(void* memory) noexcept {
+    std::free(memory);
+}
+
+void* operator new(std::size_t size) {
+    if (void* memory = countedAllocate(size, alignof(std::max_align_t))) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* memory = countedAllocate(size, alignof(std::max_align_t))) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* memory = countedAllocate(size, static_cast<std::size_t>(alignment))) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* memory = countedAllocate(size, static_cast<std::size_t>(alignment))) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept { countedRelease(memory); }
+void operator delete[](void* memory) noexcept { countedRelease(memory); }
+void operator delete(void* memory, std::size_t) noexcept { countedRelease(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { countedRelease(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { countedRelease(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { countedRelease(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { countedRelease(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { countedRelease(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { countedRelease(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { countedRelease(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { countedRelease(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { countedRelease(memory); }
+
+const int MEASURED_ACTIONS = 100;
+// The trajectory map node; a userId longer than the small-string buffer would
+// add its copy, but "alloc-test-user" fits.
+const unsigned long long FIRST_ACTION_ALLOCATIONS = 1;
+
+int main() {
+    PlayerState playerState{};
+    playerState.userId = "alloc-test-user";
+    playerState.src = "Lunor_Client_Win64_Shipping_Release_Build";
+    playerState.hwid = "alloc-test-hwid";
+    playerState.speed = 10.0;
+    playerState.movementEntropy = 0.8;
+    playerState.aimSmoothness = 0.6;
+    playerState.hitMissRatio = 0.4;
+    playerState.ipAddress = "192.168.1.4";
+    playerState.sessionId = "alloc-test-session";
+    PlayerState previousState = playerState;
+
+    Payload payload{};
+    payload.aim.angle = previousState.position.x;
+    payload.aim.timestamp = 1000000;
+    payload.fire.fireTimestamps = {1000, 1200, 1400};
+    const std::string actionType = "fire";
+
+    reserveTrajectoryCapacity(1, 1);
+
+    unsigned long long before = allocationCount.load();
+    ValidationResult first = validatePlayerAction(playerState, previousState, actionType, payload);
+    unsigned long long firstAllocations = allocationCount.load() - before;
+    if (!first.valid) {
+        std::fprintf(stderr, "FAIL: clean player rejected on first action: %.*s\n",
+            static_cast<int>(first.reason.size()), first.reason.data());
+        return 1;
+    }
+    if (firstAllocations > FIRST_ACTION_ALLOCATIONS) {
+        std::fprintf(stderr, "FAIL: %llu allocations on a new player's first action, expected at most %llu\n",
+            firstAllocations, FIRST_ACTION_ALLOCATIONS);
+        return 1;
+    }
+
+    before = allocationCount.load();
+    for (int i = 0; i < MEASURED_ACTIONS; ++i) {
+        ValidationResult result = validatePlayerAction(playerState, previousState, actionType, payload);
+        if (!result.valid) {
+            std::fprintf(stderr, "FAIL: clean player rejected on action %d: %.*s\n", i,
+                static_cast<int>(result.reason.size()), result.reason.data());
+            return 1;
+        }
+    }
+    unsigned long long allocations = allocationCount.load() - before;
+
+    if (allocations != 0) {
+        std::fprintf(stderr, "FAIL: %llu allocations over %d clean validations\n", allocations, MEASURED_ACTIONS);
+        return 1;
+    }
+    std::printf("PASS: %llu allocations on the first action, 0 over %d clean validations\n",
+        firstAllocations, MEASURED_ACTIONS);
+    return 0;
+}
@@ -0,0 +1,212 @@
+// Round-trips detection events through the columnar export format and the
+// exporter's hourly files, and checks that damaged blocks are skipped.
+//
+//   g++ -std=c++17 -O2 -pthread -Isoak/fakes tests/LunorDetectionColumnsTest.cpp -o lunor_detection_columns_test && ./lunor_detection_columns_test
+//
+// Decoded doubles must match bit for bit, including NaN and -0.0. Files are
+// written to a directory under the system temp directory and removed afterwards.
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../LunorAntiCheat.cpp"
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (condition) return;
+    std::fprintf(stderr, "FAIL: %s\n", what);
+    ++failures;
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+bool sameEvent(const DetectionEvent& a, const DetectionEvent& b) {
+    return a.timestamp == b.timestamp && a.userId == b.userId && a.cheatType == b.cheatType &&
+           sameBits(a.severity, b.severity) && sameBits(a.speed, b.speed) &&
+           sameBits(a.movementEntropy, b.movementEntropy) && sameBits(a.aimSmoothness, b.aimSmoothness) &&
+           sameBits(a.serverTickDelta, b.serverTickDelta) && sameBits(a.hitMissRatio, b.hitMissRatio) &&
+           a.suspiciousEventCount == b.suspiciousEventCount;
+}
+
+bool sameEvents(const std::vector<DetectionEvent>& a, const std::vector<DetectionEvent>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!sameEvent(a[i], b[i])) return false;
+    }
+    return true;
+}
+
+// Severity and hitMissRatio take a few values, as the detectors produce; the
+// other features are full-precision doubles with runs of repeats and a few
+// special values mixed in. Timestamps advance a second every other row and
+// jitter back and forth, so a few thousand rows stay inside one hour.
+std::vector<DetectionEvent> makeEvents(size_t rows, unsigned seed, long long timestamp) {
+    const char* const types[] = {"Speed Hack", "Aimbot Detected", "Rapid Fire", "Server Tick Delta"};
+    const double severities[] = {0.5, 0.7, 1.0};
+    const double specials[] = {
+        std::numeric_limits<double>::quiet_NaN(), -0.0, std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::max()
+    };
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<DetectionEvent> events(rows);
+    double speed = 0.0;
+    for (size_t i = 0; i < rows; ++i) {
+        DetectionEvent& event = events[i];
+        event.timestamp = timestamp + static_cast<long long>(i / 2 + rng() % 2);
+        event.userId = "player-" + std::to_string(rng() % 37);
+        event.cheatType = types[rng() % 4];
+        event.severity = severities[rng() % 3];
+        if (rng() % 4 != 0) speed = unit(rng) * 300.0;
+        event.speed = speed;
+        event.movementEntropy = rng() % 2 ? 0.1 : unit(rng);
+        event.aimSmoothness = i % 97 == 0 ? specials[(i / 97) % 5] : unit(rng);
+        event.serverTickDelta = static_cast<double>(rng() % 1000) / 1000.0;
+        event.hitMissRatio = i % 5 == 0 ? 0.25 : 0.4;
+        event.suspiciousEventCount = static_cast<long long>(rng() % 20);
+    }
+    return events;
+}
+
+void appendRows(const DetectionBlock& block, std::vector<DetectionEvent>& out) {
+    for (size_t i = 0; i < block.rows; ++i) {
+        out.push_back(DetectionEvent{
+            block.timestamp[i],
+            block.userDictionary[block.userCode[i]],
+            block.typeDictionary[block.typeCode[i]],
+            block.severity[i],
+            block.speed[i],
+            block.movementEntropy[i],
+            block.aimSmoothness[i],
+            block.serverTickDelta[i],
+            block.hitMissRatio[i],
+            block.suspiciousEventCount[i]
+        });
+    }
+}
+
+std::vector<DetectionEvent> readAll(const std::string& path, size_t& blocks, size_t& damagedBytes) {
+    std::vector<DetectionEvent> events;
+    blocks = 0;
+    damagedBytes = 0;
+    bool ok = readDetectionBlocks(path, [](const DetectionBlock&) { return true; },
+        [&](const DetectionBlock& block) {
+            ++blocks;
+            appendRows(block, events);
+        },
+        damagedBytes);
+    check(ok, "read: export file opens");
+    return events;
+}
+
+bool writeFile(const std::string& path, const std::string& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    return static_cast<bool>(file.write(data.data(), static_cast<std::streamsize>(data.size())));
+}
+
+std::string encode(const std::vector<DetectionEvent>& events) {
+    std::string encoded;
+    encodeDetectionBlock(events, encoded);
+    return encoded;
+}
+
+void testRoundTrip(const std::string& directory) {
+    const std::string path = directory + "/roundtrip.ldc";
+    std::vector<DetectionEvent> first = makeEvents(3000, 1, 1760000000);
+    std::vector<DetectionEvent> single = makeEvents(1, 2, 1760000100);
+    check(writeFile(path, encode(first) + encode(single)), "roundtrip: file written");
+
+    size_t blocks, damagedBytes;
+    std::vector<DetectionEvent> decoded = readAll(path, blocks, damagedBytes);
+    std::vector<DetectionEvent> expected = first;
+    expected.insert(expected.end(), single.begin(), single.end());
+    check(blocks == 2 && damagedBytes == 0, "roundtrip: both blocks decode cleanly");
+    check(sameEvents(decoded, expected), "roundtrip: every column matches bit for bit");
+
+    size_t visited = 0;
+    readDetectionBlocks(path, [](const DetectionBlock&) { return false; },
+        [&](const DetectionBlock&) { ++visited; }, damagedBytes);
+    check(visited == 0 && damagedBytes == 0, "roundtrip: rejected blocks are skipped, not damaged");
+}
+
+void testHourSplit(const std::string& directory) {
+    detectionExporter.directory = directory;
+    const long long hour = 1760000400 / 3600 * 3600;
+    std::vector<DetectionEvent> early = makeEvents(300, 3, hour);
+    std::vector<DetectionEvent> busy = makeEvents(DETECTION_EXPORT_BLOCK_ROWS + 100, 4, hour + 3600);
+    std::vector<DetectionEvent> late = makeEvents(50, 5, hour + 2 * 3600);
+
+    // Interleave the hours so the writer has to regroup them.
+    std::vector<DetectionEvent> batch;
+    for (size_t i = 0; i < busy.size(); ++i) {
+        if (i < late.size()) batch.push_back(late[i]);
+        batch.push_back(busy[i]);
+        if (i < early.size()) batch.push_back(early[i]);
+    }
+    writeDetectionBatch(batch);
+
+    const std::vector<DetectionEvent>* hours[] = {&early, &busy, &late};
+    const size_t expectedBlocks[] = {1, 2, 1};
+    for (int h = 0; h < 3; ++h) {
+        size_t blocks, damagedBytes;
+        std::vector<DetectionEvent> decoded = readAll(detectionExportPath(hour + h * 3600), blocks, damagedBytes);
+        check(sameEvents(decoded, *hours[h]), "hours: each hour file holds exactly its events, in order");
+        check(blocks == expectedBlocks[h], "hours: blocks are capped at DETECTION_EXPORT_BLOCK_ROWS");
+        check(damagedBytes == 0, "hours: no damaged bytes");
+    }
+}
+
+void testDamagedBlocks(const std::string& directory) {
+    const std::string path = directory + "/damaged.ldc";
+    std::vector<DetectionEvent> a = makeEvents(100, 6, 1760000000);
+    std::vector<DetectionEvent> b = makeEvents(200, 7, 1760000000);
+    std::vector<DetectionEvent> c = makeEvents(50, 8, 1760000000);
+    // A false magic inside the torn block's payload must not stop the resync.
+    for (auto& event : b) event.userId = "LDC3" + event.userId;
+
+    std::string blockA = encode(a);
+    std::string torn = encode(b).substr(0, 700);
+    std::string blockC = encode(c);
+    std::string corruptA = blockA;
+    corruptA[corruptA.size() / 2] ^= 0x40;
+    const std::string junk = "junk";
+    check(writeFile(path, junk + blockA + torn + blockC + corruptA + blockC + blockC.substr(0, 6)),
+        "damaged: file written");
+
+    size_t blocks, damagedBytes;
+    std::vector<DetectionEvent> decoded = readAll(path, blocks, damagedBytes);
+    std::vector<DetectionEvent> expected = a;
+    expected.insert(expected.end(), c.begin(), c.end());
+    expected.insert(expected.end(), c.begin(), c.end());
+    check(blocks == 3, "damaged: every intact block after a torn one is read");
+    check(sameEvents(decoded, expected), "damaged: intact blocks decode exactly");
+    check(damagedBytes == junk.size() + torn.size() + corruptA.size() + 6,
+        "damaged: exactly the junk, torn, corrupt and truncated bytes are skipped");
+}
+
+int main() {
+    namespace fs = std::filesystem;
+    const fs::path directory = fs::temp_directory_path() / "lunor_detection_columns_test";
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+
+    testRoundTrip(directory.string());
+    testHourSplit(directory.string());
+    testDamagedBlocks(directory.string());
+    fs::remove_all(directory);
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d detection column checks failed\n", failures);
+        return 1;
+    }
+    std::printf("PASS: detection export round-trips and resyncs\n");
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Checks the custom pak verification: SHA-256 and HMAC-SHA256 against published
+// known-answer vectors, the custom_cosmetics.json loader, and the verdict cache
+// across tampering and signing key rotation.
+//
+//   g++ -std=c++17 -O2 -pthread -Isoak/fakes tests/LunorPakTest.cpp -o lunor_pak_test && ./lunor_pak_test
+//
+// Run from the repository root so custom_cosmetics.json is found. The test pak
+// is written to the system temp directory and removed afterwards.
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "../LunorAntiCheat.cpp"
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (condition) return;
+    std::fprintf(stderr, "FAIL: %s\n", what);
+    ++failures;
+}
+
+void checkHex(const Sha256Digest& digest, const char* expected, const char* what) {
+    if (toHex(digest) == expected) return;
+    std::fprintf(stderr, "FAIL: %s: got %s, expected %s\n", what, toHex(digest).c_str(), expected);
+    ++failures;
+}
+
+size_t cachedVerdicts() {
+    std::lock_guard<std::mutex> lock(pakVerdictCacheMutex);
+    return pakVerdictCache.size();
+}
+
+bool writeFile(const std::string& path, const std::string& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    return static_cast<bool>(file.write(data.data(), static_cast<std::streamsize>(data.size())));
+}
+
+// FIPS 180-2 examples and RFC 4231 test cases 1, 2 and 6 (key longer than a block).
+void testKnownAnswers() {
+    checkHex(sha256(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", "sha256 empty");
+    checkHex(sha256("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", "sha256 abc");
+    checkHex(sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", "sha256 two blocks");
+    checkHex(sha256(std::string(1000000, 'a')),
+        "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", "sha256 million a");
+
+    Sha256 streamed;
+    std::string message(1000, 'x');
+    for (size_t i = 0; i < message.size(); i += 7) streamed.update(std::string_view(message).substr(i, 7));
+    check(toHex(streamed.finish()) == toHex(sha256(message)), "sha256 streamed updates match one-shot");
+
+    checkHex(hmacSha256(std::string(20, '\x0b'), "Hi There"),
+        "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7", "hmac rfc4231 case 1");
+    checkHex(hmacSha256("Jefe", "what do ya want for nothing?"),
+        "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843", "hmac rfc4231 case 2");
+    checkHex(hmacSha256(std::string(131, '\xaa'), "Test Using Larger Than Block-Size Key - Hash Key First"),
+        "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54", "hmac rfc4231 case 6");
+}
+
+void testCosmeticsLoader() {
+    check(loadCustomCosmeticItems("custom_cosmetics.json"), "cosmetics: custom_cosmetics.json loads");
+    std::shared_lock<std::shared_mutex> lock(pakRegistryMutex);
+    check(customCosmeticItems.size() == 69, "cosmetics: every id is collected");
+    check(customCosmeticItems.count("cid_a_chani_lunor") == 1, "cosmetics: ids are lowercased");
+    check(customCosmeticItems.count("skin") == 0, "cosmetics: non-id values are ignored");
+    check(customCosmeticItems.count("lunor customs") == 0, "cosmetics: name values are ignored");
+}
+
+void testVerdictCache() {
+    namespace fs = std::filesystem;
+    const std::string pakPath = (fs::temp_directory_path() / "lunor_pak_test.pak").string();
+    const std::string sigPath = (fs::temp_directory_path() / "lunor_pak_test.sig").string();
+
+    std::string pak(PAK_CHUNK_SIZE * 2 + 12345, '\0');
+    for (size_t i = 0; i < pak.size(); ++i) pak[i] = static_cast<char>((i * 2654435761u) >> 13);
+    std::vector<std::string> chunkHashes;
+    for (size_t offset = 0; offset < pak.size(); offset += PAK_CHUNK_SIZE) {
+        chunkHashes.push_back(toHex(sha256(std::string_view(pak).substr(offset, PAK_CHUNK_SIZE))));
+    }
+    const std::string oldKey = "lunor-test-key-1";
+    const std::string newKey = "lunor-test-key-2";
+    std::string signature = toHex(hmacSha256(oldKey, manifestRoot(chunkHashes)));
+    check(writeFile(pakPath, pak) && writeFile(sigPath, signature + "\n"), "cache: test pak written");
+
+    loadPakSigningKey(oldKey);
+    check(loadTrustedPak("Lunor_Custom_Cosmatics.pak", pakPath, sigPath), "cache: trusted pak loads");
+
+    PakManifest manifest{"lunor_custom_cosmatics.pak", chunkHashes, signature, {"CID_a_chani_Lunor", "cid_lyric_lunor"}};
+    check(verifyCustomPakManifest(manifest) == PakVerdict::Verified, "cache: matching manifest verifies");
+    check(cachedVerdicts() == 1, "cache: verdict is memoized");
+    check(verifyCustomPakManifest(manifest) == PakVerdict::Verified, "cache: cached verdict is reused");
+    check(cachedVerdicts() == 1, "cache: same content shares one entry");
+
+    PakManifest unknownItem = manifest;
+    unknownItem.itemIds.push_back("cid_not_in_catalog");
+    check(verifyCustomPakManifest(unknownItem) == PakVerdict::UnknownItem, "cache: unknown item rejected");
+
+    PakManifest tampered = manifest;
+    tampered.chunkHashes[1][0] = tampered.chunkHashes[1][0] == '0' ? '1' : '0';
+    check(verifyCustomPakManifest(tampered) == PakVerdict::ChunkMismatch, "cache: tampered chunk rejected");
+
+    PakManifest forged = manifest;
+    forged.signature = toHex(hmacSha256("attacker-key", manifestRoot(chunkHashes)));
+    check(verifyCustomPakManifest(forged) == PakVerdict::BadSignature, "cache: forged signature rejected");
+
+    PakManifest otherPak = manifest;
+    otherPak.pakName = "other.pak";
+    check(verifyCustomPakManifest(otherPak) == PakVerdict::UnknownPak, "cache: unknown pak rejected");
+
+    loadPakSigningKey(newKey);
+    check(cachedVerdicts() == 0, "rotation: key change clears the verdict cache");
+    check(verifyCustomPakManifest(manifest) == PakVerdict::UnknownPak, "rotation: old trusted paks dropped");
+    check(!loadTrustedPak("lunor_custom_cosmatics.pak", pakPath, sigPath), "rotation: old-key .sig refused");
+
+    std::string newSignature = toHex(hmacSha256(newKey, manifestRoot(chunkHashes)));
+    check(writeFile(sigPath, newSignature), "rotation: re-signed .sig written");
+    check(loadTrustedPak("lunor_custom_cosmatics.pak", pakPath, sigPath), "rotation: re-signed pak loads");
+    check(verifyCustomPakManifest(manifest) == PakVerdict::BadSignature, "rotation: old-key manifest rejected");
+    manifest.signature = newSignature;
+    check(verifyCustomPakManifest(manifest) == PakVerdict::Verified, "rotation: new-key manifest verifies");
+
+    fs::remove(pakPath);
+    fs::remove(sigPath);
+}
+
+int main() {
+    testKnownAnswers();
+    testCosmeticsLoader();
+    testVerdictCache();
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d pak checks failed\n", failures);
+        return 1;
+    }
+    std::printf("PASS: pak hashing, signatures and verdict cache\n");
+    return 0;
+}
@@ -0,0 +1,209 @@
+// Round-trips samples through the trajectory history and checks retention.
+//
+//   g++ -std=c++17 -O2 -pthread -Isoak/fakes tests/LunorTrajectoryTest.cpp -o lunor_trajectory_test && ./lunor_trajectory_test
+//
+// Each case records into its own userId and decodes it back with
+// forEachTrajectorySample. Positions must come back to within the quantization
+// step, aim angles normalized to [0, 360), and timestamps never decreasing. The
+// footprint case holds the store to ten minutes of 30 Hz history for 100
+// players in TRAJECTORY_FOOTPRINT_LIMIT bytes.
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../LunorAntiCheat.cpp"
+
+const size_t TRAJECTORY_FOOTPRINT_LIMIT = 4 << 20;
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (condition) return;
+    std::fprintf(stderr, "FAIL: %s\n", what);
+    ++failures;
+}
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 0.051;
+}
+
+std::vector<TrajectorySample> decodeAll(const std::string& userId) {
+    std::vector<TrajectorySample> samples;
+    forEachTrajectorySample(userId, LLONG_MIN, LLONG_MAX, [&](const TrajectorySample& sample) {
+        samples.push_back(sample);
+    });
+    return samples;
+}
+
+size_t chunkCount(const std::string& userId) {
+    TrajectoryShard& shard = trajectoryShard(userId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.players.find(userId);
+    if (it == shard.players.end()) return 0;
+    size_t chunks = 0;
+    for (const TrajectoryChunk* chunk = it->second.head; chunk; chunk = chunk->next) ++chunks;
+    return chunks;
+}
+
+void testAngles() {
+    const double recorded[] = {500.0, -170.0, 175.0, -190.0, 359.95, 0.0, -720.5, 179.9, -179.9, 1e6};
+    const double expected[] = {140.0, 190.0, 175.0, 170.0, 0.0, 0.0, 359.5, 179.9, 180.1, 280.0};
+    long long timestamp = 1000;
+    for (double angle : recorded) recordTrajectory("angles", timestamp += 16, 0.0, 0.0, angle);
+
+    std::vector<TrajectorySample> samples = decodeAll("angles");
+    check(samples.size() == sizeof(recorded) / sizeof(recorded[0]), "angles: sample count");
+    for (size_t i = 0; i < samples.size(); ++i) {
+        if (!near(samples[i].aimAngle, expected[i])) {
+            std::fprintf(stderr, "FAIL: angle %zu recorded %.2f decoded %.2f, expected %.2f\n",
+                i, recorded[i], samples[i].aimAngle, expected[i]);
+            ++failures;
+        }
+    }
+}
+
+void testPositionsAcrossChunks() {
+    const int samplesRecorded = 2000;
+    for (int i = 0; i < samplesRecorded; ++i) {
+        double x = 1000.0 * std::sin(i * 0.37) + i * 3.1;
+        double y = -500.0 + (i % 7) * 123.45;
+        recordTrajectory("positions", 5000 + i * 16 + (i % 3), x, y, i * 13.7);
+    }
+    check(chunkCount("positions") > 1, "positions: samples should span several chunks");
+
+    std::vector<TrajectorySample> samples = decodeAll("positions");
+    check(samples.size() == static_cast<size_t>(samplesRecorded), "positions: sample count");
+    for (size_t i = 0; i < samples.size(); ++i) {
+        double x = 1000.0 * std::sin(i * 0.37) + i * 3.1;
+        double y = -500.0 + (i % 7) * 123.45;
+        double angle = std::fmod(i * 13.7, 360.0);
+        if (samples[i].timestamp != static_cast<long long>(5000 + i * 16 + (i % 3)) ||
+            !near(samples[i].x, x) || !near(samples[i].y, y) ||
+            !(near(samples[i].aimAngle, angle) || near(samples[i].aimAngle + 360.0, angle))) {
+            std::fprintf(stderr, "FAIL: position sample %zu decoded (%lld, %.2f, %.2f, %.2f)\n",
+                i, samples[i].timestamp, samples[i].x, samples[i].y, samples[i].aimAngle);
+            ++failures;
+            return;
+        }
+    }
+}
+
+void testMixedMagnitudes() {
+    // Values that jump between every bit class, including the 64-bit escape.
+    std::mt19937_64 rng(12345);
+    const double scales[] = {0.0, 0.1, 1.0, 30.0, 2000.0, 1e9};
+    std::vector<TrajectorySample> recorded;
+    long long timestamp = 7000;
+    for (int i = 0; i < 3000; ++i) {
+        double scale = scales[rng() % 6];
+        double x = (static_cast<double>(rng() % 2000001) - 1000000.0) / 1000000.0 * scale;
+        double y = (static_cast<double>(rng() % 2000001) - 1000000.0) / 1000000.0 * scales[rng() % 6];
+        double angle = static_cast<double>(rng() % 3600) / 10.0;
+        timestamp += static_cast<long long>(rng() % 50 == 0 ? rng() % 10000 : rng() % 40);
+        recordTrajectory("mixed", timestamp, x, y, angle);
+        recorded.push_back(TrajectorySample{timestamp, x, y, angle});
+    }
+
+    std::vector<TrajectorySample> samples = decodeAll("mixed");
+    check(samples.size() == recorded.size(), "mixed: sample count");
+    for (size_t i = 0; i < samples.size() && i < recorded.size(); ++i) {
+        if (samples[i].timestamp != recorded[i].timestamp || !near(samples[i].x, recorded[i].x) ||
+            !near(samples[i].y, recorded[i].y) || !near(samples[i].aimAngle, recorded[i].aimAngle)) {
+            std::fprintf(stderr, "FAIL: mixed sample %zu decoded (%lld, %.2f, %.2f, %.2f), recorded (%lld, %.2f, %.2f, %.2f)\n",
+                i, samples[i].timestamp, samples[i].x, samples[i].y, samples[i].aimAngle,
+                recorded[i].timestamp, recorded[i].x, recorded[i].y, recorded[i].aimAngle);
+            ++failures;
+            return;
+        }
+    }
+}
+
+void testHostileValues() {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    recordTrajectory("hostile", 2000, 1.0, 2.0, 3.0);
+    recordTrajectory("hostile", 1000, inf, -inf, nan);
+    recordTrajectory("hostile", 3000, -1e300, 1e300, inf);
+    recordTrajectory("hostile", 4000, 4.0, 5.0, 6.0);
+
+    std::vector<TrajectorySample> samples = decodeAll("hostile");
+    check(samples.size() == 4, "hostile: sample count");
+    if (samples.size() != 4) return;
+    check(samples[1].timestamp == 2000, "hostile: earlier timestamp is clamped to the previous sample");
+    for (size_t i = 1; i < samples.size(); ++i) {
+        check(samples[i].timestamp >= samples[i - 1].timestamp, "hostile: timestamps never decrease");
+        check(samples[i].aimAngle >= 0.0 && samples[i].aimAngle < 360.0, "hostile: angle stays in [0, 360)");
+    }
+    check(near(samples[3].x, 4.0) && near(samples[3].y, 5.0) && near(samples[3].aimAngle, 6.0),
+        "hostile: sane sample after clamped ones decodes exactly");
+}
+
+void testRetentionAndSweep() {
+    long long start = 1000000000;
+    for (int i = 0; i < 3000; ++i) recordTrajectory("retention", start + i * 1000LL, i, i, 0.0);
+    long long last = start + 2999 * 1000LL;
+
+    std::vector<TrajectorySample> samples = decodeAll("retention");
+    check(!samples.empty(), "retention: recent samples kept");
+    check(samples.back().timestamp == last, "retention: newest sample kept");
+    check(samples.front().timestamp >= last - TRAJECTORY_RETENTION_MS - 1000LL * static_cast<long long>(TRAJECTORY_CHUNK_BYTES),
+        "retention: expired chunks released");
+
+    recordTrajectory("idle", start, 1.0, 1.0, 1.0);
+    sweepTrajectories(last);
+    check(chunkCount("idle") == 0, "sweep: idle player dropped");
+    check(chunkCount("retention") > 0, "sweep: active player kept");
+
+    sweepTrajectories(last + TRAJECTORY_RETENTION_MS + 1);
+    check(chunkCount("retention") == 0, "sweep: player dropped once idle past retention");
+}
+
+// Smooth movement and aim with 1 ms receive jitter, as a 30 Hz client produces.
+void testFootprint() {
+    const int players = 100;
+    const int hz = 30;
+    const int seconds = static_cast<int>(TRAJECTORY_RETENTION_MS / 1000);
+    size_t chunksBefore = trajectoryChunkPool.chunksInUse();
+    std::mt19937 rng(7);
+    for (int p = 0; p < players; ++p) {
+        std::string userId = "footprint-" + std::to_string(p);
+        double phase = p * 0.7;
+        for (int i = 0; i < hz * seconds; ++i) {
+            double t = static_cast<double>(i) / hz;
+            long long timestamp = 1700000000000LL + static_cast<long long>(i * 1000.0 / hz) + static_cast<long long>(rng() % 2);
+            double x = 200.0 * std::sin(0.05 * t + phase) + 3.0 * t;
+            double y = 150.0 * std::cos(0.031 * t + phase);
+            double angle = 40.0 * t + 30.0 * std::sin(0.5 * t + phase);
+            recordTrajectory(userId, timestamp, x, y, angle);
+        }
+    }
+
+    size_t bytes = (trajectoryChunkPool.chunksInUse() - chunksBefore) * sizeof(TrajectoryChunk);
+    double perSample = static_cast<double>(bytes) / (static_cast<double>(players) * hz * seconds);
+    std::printf("footprint: %d players x %d s x %d Hz in %.2f MiB (%.2f bytes/sample)\n",
+        players, seconds, hz, bytes / 1048576.0, perSample);
+    check(bytes <= TRAJECTORY_FOOTPRINT_LIMIT, "footprint: ten minutes of 100 players fits TRAJECTORY_FOOTPRINT_LIMIT");
+    for (int p = 0; p < players; ++p) forgetTrajectory("footprint-" + std::to_string(p));
+}
+
+int main() {
+    testAngles();
+    testPositionsAcrossChunks();
+    testMixedMagnitudes();
+    testHostileValues();
+    testRetentionAndSweep();
+    testFootprint();
+
+    for (const char* userId : {"angles", "positions", "mixed", "hostile"}) forgetTrajectory(userId);
+    check(trajectoryChunkPool.chunksInUse() == 0, "all chunks returned to the pool");
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d trajectory checks failed\n", failures);
+        return 1;
+    }
+    std::printf("PASS: trajectory history round-trips\n");
+    return 0;
+}